@@ -0,0 +1,59 @@
+description(
+"Tests that the DFG keeps the bounds check of a typed array access when the loop bound is not the length of the accessed array."
+);
+
+function makeArray(length) {
+    var result = new Int32Array(length);
+    for (var i = 0; i < length; ++i)
+        result[i] = i + 1;
+    return result;
+}
+
+// Out of bounds elements count as 1000, so that reading anything else shows.
+function sumUpTo(a, n) {
+    var s = 0;
+    for (var i = 0; i < n; ++i) {
+        var v = a[i];
+        s += v === undefined ? 1000 : v;
+    }
+    return s;
+}
+
+function sumUpToOtherLength(a, b) {
+    var s = 0;
+    for (var i = 0; i < b.length; ++i) {
+        var v = a[i];
+        s += v === undefined ? 1000 : v;
+    }
+    return s;
+}
+
+function sumUpToAndIncludingLength(a) {
+    var s = 0;
+    for (var i = 0; i <= a.length; ++i) {
+        var v = a[i];
+        s += v === undefined ? 1000 : v;
+    }
+    return s;
+}
+
+// The references run on plain arrays, so their code has no typed array accesses.
+var referenceSumUpTo = eval("(" + sumUpTo + ")");
+var referenceSumUpToOtherLength = eval("(" + sumUpToOtherLength + ")");
+var referenceSumUpToAndIncludingLength = eval("(" + sumUpToAndIncludingLength + ")");
+
+var a = makeArray(1000);
+var b = makeArray(1010);
+var plainA = Array.prototype.slice.call(a);
+var plainB = Array.prototype.slice.call(b);
+
+for (var k = 0; k < 100; ++k) {
+    sumUpTo(a, a.length);
+    sumUpToOtherLength(a, a);
+    sumUpToAndIncludingLength(a);
+}
+
+shouldBe("sumUpTo(a, 1000)", "referenceSumUpTo(plainA, 1000)");
+shouldBe("sumUpTo(a, 1005)", "referenceSumUpTo(plainA, 1005)");
+shouldBe("sumUpToOtherLength(a, b)", "referenceSumUpToOtherLength(plainA, plainB)");
+shouldBe("sumUpToAndIncludingLength(a)", "referenceSumUpToAndIncludingLength(plainA)");
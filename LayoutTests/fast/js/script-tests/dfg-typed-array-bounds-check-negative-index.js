@@ -0,0 +1,61 @@
+description(
+"Tests that the DFG keeps the bounds check of a typed array access whose index may be negative or not an int32, even when it is guarded by a comparison with the length."
+);
+
+function makeArray(length) {
+    var result = new Int32Array(length);
+    for (var i = 0; i < length; ++i)
+        result[i] = i + 1;
+    return result;
+}
+
+// Out of bounds elements count as 1000, so that reading anything else shows.
+function sumFrom(a, start) {
+    var s = 0;
+    for (var i = start; i < a.length; ++i) {
+        var v = a[i];
+        s += v === undefined ? 1000 : v;
+    }
+    return s;
+}
+
+function sumFromMinusTwo(a) {
+    var s = 0;
+    for (var i = -2; i < a.length; ++i) {
+        var v = a[i];
+        s += v === undefined ? 1000 : v;
+    }
+    return s;
+}
+
+function sumShiftedBack(a) {
+    var s = 0;
+    for (var i = 0; i < a.length; ++i) {
+        var j = i - 3;
+        if (j < a.length) {
+            var v = a[j];
+            s += v === undefined ? 1000 : v;
+        }
+    }
+    return s;
+}
+
+// The references run on plain arrays, so their code has no typed array accesses.
+var referenceSumFrom = eval("(" + sumFrom + ")");
+var referenceSumFromMinusTwo = eval("(" + sumFromMinusTwo + ")");
+var referenceSumShiftedBack = eval("(" + sumShiftedBack + ")");
+
+var a = makeArray(1000);
+var plain = Array.prototype.slice.call(a);
+
+for (var k = 0; k < 100; ++k) {
+    sumFrom(a, 0);
+    sumFromMinusTwo(a);
+    sumShiftedBack(a);
+}
+
+shouldBe("sumFrom(a, 0)", "referenceSumFrom(plain, 0)");
+shouldBe("sumFrom(a, -3)", "referenceSumFrom(plain, -3)");
+shouldBe("sumFrom(a, 0.5)", "referenceSumFrom(plain, 0.5)");
+shouldBe("sumFromMinusTwo(a)", "referenceSumFromMinusTwo(plain)");
+shouldBe("sumShiftedBack(a)", "referenceSumShiftedBack(plain)");
@@ -0,0 +1,46 @@
+description(
+"Tests that the DFG keeps the bounds check of a typed array access when a call between the length comparison and the access neuters the array. Neutering is the only way the length of a typed array can change."
+);
+
+function makeArray(length) {
+    var result = new Int32Array(length);
+    for (var i = 0; i < length; ++i)
+        result[i] = i + 1;
+    return result;
+}
+
+function neuter(array) {
+    window.postMessage(null, "*", [array.buffer]);
+}
+
+function maybeNeuter(array, i, when) {
+    if (i == when)
+        neuter(array);
+}
+
+// Out of bounds elements count as 1000, so that reading anything else shows.
+function sumNeuteringAt(a, when) {
+    var s = 0;
+    for (var i = 0; i < a.length; ++i) {
+        maybeNeuter(a, i, when);
+        var v = a[i];
+        s += v === undefined ? 1000 : v;
+    }
+    return s;
+}
+
+function storeNeuteringAt(a, when) {
+    for (var i = 0; i < a.length; ++i)
+        a[i] = maybeNeuter(a, i, when) === undefined ? i : 0;
+    return a.length;
+}
+
+for (var k = 0; k < 200; ++k) {
+    sumNeuteringAt(makeArray(100), -1);
+    storeNeuteringAt(makeArray(100), -1);
+}
+
+// Elements 1 to 10 are read before the array is neutered, then the
+// element at index 10 is read from the empty array.
+shouldBe("sumNeuteringAt(makeArray(100), 10)", "1055");
+shouldBe("storeNeuteringAt(makeArray(100), 10)", "0");
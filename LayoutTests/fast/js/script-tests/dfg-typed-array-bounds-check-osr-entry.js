@@ -0,0 +1,62 @@
+description(
+"Tests that the DFG keeps the bounds check of a typed array access in a loop entered through OSR, when the induction variable goes out of bounds."
+);
+
+function makeArray(length) {
+    var result = new Int32Array(length);
+    for (var i = 0; i < length; ++i)
+        result[i] = i + 1;
+    return result;
+}
+
+// Out of bounds elements count as 1000, so that reading anything else shows.
+// Each function is called once, so its loop is compiled and entered through OSR.
+function sumRestartingAt(a, when) {
+    var s = 0;
+    for (var i = 0; i < a.length; ++i) {
+        if (i == when) {
+            i = -5;
+            when = -10;
+        }
+        var v = a[i];
+        s += v === undefined ? 1000 : v;
+    }
+    return s;
+}
+
+function sumSwitchingAt(a, b, when) {
+    var s = 0;
+    for (var i = 0; i < a.length; ++i) {
+        if (i == when)
+            a = b;
+        var v = a[i];
+        s += v === undefined ? 1000 : v;
+    }
+    return s;
+}
+
+function sumInner(a, n) {
+    var s = 0;
+    for (var i = 0; i < n; ++i) {
+        var j = i & 0xffff;
+        if (j < a.length) {
+            var v = a[j - 1];
+            s += v === undefined ? 1000 : v;
+        }
+    }
+    return s;
+}
+
+// The references run on plain arrays, so their code has no typed array accesses.
+var referenceSumRestartingAt = eval("(" + sumRestartingAt + ")");
+var referenceSumSwitchingAt = eval("(" + sumSwitchingAt + ")");
+var referenceSumInner = eval("(" + sumInner + ")");
+
+var a = makeArray(100000);
+var b = makeArray(50000);
+var plainA = Array.prototype.slice.call(a);
+var plainB = Array.prototype.slice.call(b);
+
+shouldBe("sumRestartingAt(a, 90000)", "referenceSumRestartingAt(plainA, 90000)");
+shouldBe("sumSwitchingAt(a, b, 90000)", "referenceSumSwitchingAt(plainA, plainB, 90000)");
+shouldBe("sumInner(a, 200000)", "referenceSumInner(plainA, 200000)");
@@ -0,0 +1,67 @@
+description(
+"Tests that the DFG keeps the bounds check of a typed array access when the index or the array is reassigned between the length comparison and the access."
+);
+
+function makeArray(length) {
+    var result = new Int32Array(length);
+    for (var i = 0; i < length; ++i)
+        result[i] = i + 1;
+    return result;
+}
+
+// Out of bounds elements count as 1000, so that reading anything else shows.
+function sumSkippingAt(a, limit) {
+    var s = 0;
+    for (var i = 0; i < a.length; ++i) {
+        if (i == limit)
+            i += 7;
+        var v = a[i];
+        s += v === undefined ? 1000 : v;
+    }
+    return s;
+}
+
+function sumSwitchingAt(a, b, when) {
+    var s = 0;
+    for (var i = 0; i < a.length; ++i) {
+        if (i == when)
+            a = b;
+        var v = a[i];
+        s += v === undefined ? 1000 : v;
+    }
+    return s;
+}
+
+function sumSwitchingAfterCheck(a, b, when) {
+    var s = 0;
+    for (var i = 0; i < 2000; ++i) {
+        if (i < a.length) {
+            if (i == when)
+                a = b;
+            var v = a[i];
+            s += v === undefined ? 1000 : v;
+        }
+    }
+    return s;
+}
+
+// The references run on plain arrays, so their code has no typed array accesses.
+var referenceSumSkippingAt = eval("(" + sumSkippingAt + ")");
+var referenceSumSwitchingAt = eval("(" + sumSwitchingAt + ")");
+var referenceSumSwitchingAfterCheck = eval("(" + sumSwitchingAfterCheck + ")");
+
+var a = makeArray(1000);
+var b = makeArray(20);
+var plainA = Array.prototype.slice.call(a);
+var plainB = Array.prototype.slice.call(b);
+
+for (var k = 0; k < 100; ++k) {
+    sumSkippingAt(a, -1);
+    sumSwitchingAt(a, a, -1);
+    sumSwitchingAfterCheck(a, a, -1);
+}
+
+shouldBe("sumSkippingAt(a, -1)", "referenceSumSkippingAt(plainA, -1)");
+shouldBe("sumSkippingAt(a, 996)", "referenceSumSkippingAt(plainA, 996)");
+shouldBe("sumSwitchingAt(a, b, 10)", "referenceSumSwitchingAt(plainA, plainB, 10)");
+shouldBe("sumSwitchingAfterCheck(a, b, 10)", "referenceSumSwitchingAfterCheck(plainA, plainB, 10)");
@@ -103,9 +103,46 @@ void JSGarbageCollect(JSContextRef ctx)
     exec->globalData().heap.reportAbandonedObjectGraph();
 }
 
+void JSSynchronousGarbageCollectForDebugging(JSContextRef ctx)
+{
+    if (!ctx)
+        return;
+
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+    exec->globalData().heap.collectAllGarbage();
+}
+
 void JSReportExtraMemoryCost(JSContextRef ctx, size_t size)
 {
     ExecState* exec = toJS(ctx);
     APIEntryShim entryShim(exec);
     exec->globalData().heap.reportExtraMemoryCost(size);
 }
+
+bool JSGetGarbageCollectionPhaseStatistics(JSContextRef ctx, JSGarbageCollectionPhase phase, JSGarbageCollectionPhaseStatistics* statistics)
+{
+    COMPILE_ASSERT(static_cast<int>(kJSGarbageCollectionPhaseCollection) == static_cast<int>(GCPauseStatistics::Collection), JSGarbageCollectionPhase_matches_GCPauseStatistics_Phase);
+    if (static_cast<unsigned>(phase) >= static_cast<unsigned>(GCPauseStatistics::NumberOfPhases)) {
+        memset(statistics, 0, sizeof(*statistics));
+        return false;
+    }
+
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+    const GCPauseHistogram& histogram = exec->globalData().heap.pauseStatistics().histogram(static_cast<GCPauseStatistics::Phase>(phase));
+    statistics->count = histogram.count();
+    statistics->total = histogram.total() * 1000;
+    statistics->maximum = histogram.maximum() * 1000;
+    statistics->median = histogram.percentile(0.5) * 1000;
+    statistics->percentile90 = histogram.percentile(0.9) * 1000;
+    statistics->percentile99 = histogram.percentile(0.99) * 1000;
+    return true;
+}
+
+void JSResetGarbageCollectionStatistics(JSContextRef ctx)
+{
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+    exec->globalData().heap.clearPauseStatistics();
+}
@@ -29,6 +29,46 @@
 #include <JavaScriptCore/JSBase.h>
 #include <JavaScriptCore/WebKitAvailability.h>
 
+/*!
+@enum JSGarbageCollectionPhase
+@abstract     A constant identifying a phase of garbage collection.
+@constant     kJSGarbageCollectionPhaseRootMarking      Visiting the roots and what they reference.
+@constant     kJSGarbageCollectionPhaseConservativeScan Scanning the machine and JavaScript stacks for roots.
+@constant     kJSGarbageCollectionPhaseParallelMarking  Marking with all the marker threads until there is no work left.
+@constant     kJSGarbageCollectionPhaseWeakHarvesting   Visiting weak handles and references, and clearing the dead ones.
+@constant     kJSGarbageCollectionPhaseCopying          Evacuating the backing stores of the live objects.
+@constant     kJSGarbageCollectionPhaseSweeping         Sweeping the whole heap, which only full collections do eagerly.
+@constant     kJSGarbageCollectionPhaseCollection       The whole pause of a collection.
+*/
+typedef enum {
+    kJSGarbageCollectionPhaseRootMarking,
+    kJSGarbageCollectionPhaseConservativeScan,
+    kJSGarbageCollectionPhaseParallelMarking,
+    kJSGarbageCollectionPhaseWeakHarvesting,
+    kJSGarbageCollectionPhaseCopying,
+    kJSGarbageCollectionPhaseSweeping,
+    kJSGarbageCollectionPhaseCollection
+} JSGarbageCollectionPhase;
+
+/*!
+@struct JSGarbageCollectionPhaseStatistics
+@abstract The times spent in a phase of garbage collection, in milliseconds.
+@field count The number of times the phase ran.
+@field total The time spent in the phase overall.
+@field maximum The longest time the phase took.
+@field median The median time, rounded up to a power of two microseconds.
+@field percentile90 The 90th percentile, rounded up like the median.
+@field percentile99 The 99th percentile, rounded up like the median.
+*/
+typedef struct {
+    size_t count;
+    double total;
+    double maximum;
+    double median;
+    double percentile90;
+    double percentile99;
+} JSGarbageCollectionPhaseStatistics;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -45,6 +85,36 @@ region.
 */
 JS_EXPORT void JSReportExtraMemoryCost(JSContextRef ctx, size_t size) AVAILABLE_IN_WEBKIT_VERSION_4_0;
 
+/*!
+@function
+@abstract Performs a full garbage collection immediately.
+@param ctx The execution context whose heap to collect.
+@discussion Unlike JSGarbageCollect, which only makes the next collection come
+sooner, this collects before it returns. It is meant for tests.
+*/
+JS_EXPORT void JSSynchronousGarbageCollectForDebugging(JSContextRef ctx) AVAILABLE_IN_WEBKIT_VERSION_4_0;
+
+/*!
+@function
+@abstract Gets the times spent in a phase of garbage collection.
+@param ctx The execution context whose heap to query.
+@param phase The phase to query.
+@param statistics A pointer to the structure in which to store the times.
+@result false, with the times all zero, if phase is not a valid phase; otherwise true.
+@discussion The times cover every collection of the heap since it was created,
+or since the statistics were last reset with JSResetGarbageCollectionStatistics.
+They are kept in histograms of constant size, so they are cheap enough to
+gather in release builds.
+*/
+JS_EXPORT bool JSGetGarbageCollectionPhaseStatistics(JSContextRef ctx, JSGarbageCollectionPhase phase, JSGarbageCollectionPhaseStatistics* statistics) AVAILABLE_IN_WEBKIT_VERSION_4_0;
+
+/*!
+@function
+@abstract Forgets the garbage collection times gathered so far.
+@param ctx The execution context whose heap to reset.
+*/
+JS_EXPORT void JSResetGarbageCollectionStatistics(JSContextRef ctx) AVAILABLE_IN_WEBKIT_VERSION_4_0;
+
 #ifdef __cplusplus
 }
 #endif
@@ -28,6 +28,7 @@
 #include "JSContextRefPrivate.h"
 
 #include "APICast.h"
+#include "CodeCache.h"
 #include "InitializeThreading.h"
 #include <interpreter/CallFrame.h>
 #include <interpreter/Interpreter.h>
@@ -68,6 +69,48 @@ void JSContextGroupRelease(JSContextGroupRef group)
     toJS(group)->deref();
 }
 
+class HeapSizeLimitCallbackClient : public HeapSizeLimitClient {
+public:
+    HeapSizeLimitCallbackClient(JSHeapSizeLimitCallback callback, void* context)
+        : m_callback(callback)
+        , m_context(context)
+    {
+    }
+
+    virtual void didExceedHeapSizeLimit(JSGlobalData& globalData, JSGlobalObject* globalObject)
+    {
+        m_callback(toRef(&globalData), globalObject ? toRef(globalObject->globalExec()) : 0, m_context);
+    }
+
+private:
+    JSHeapSizeLimitCallback m_callback;
+    void* m_context;
+};
+
+void JSContextGroupSetHeapSizeLimit(JSContextGroupRef group, size_t limit, JSHeapSizeLimitCallback callback, void* context)
+{
+    JSGlobalData& globalData = *toJS(group);
+    APIEntryShim entryShim(&globalData);
+    OwnPtr<HeapSizeLimitClient> client;
+    if (callback)
+        client = adoptPtr(new HeapSizeLimitCallbackClient(callback, context));
+    globalData.heap.setHeapSizeLimit(limit, client.release());
+}
+
+bool JSContextGroupLoadBytecodeCache(JSContextGroupRef group, const char* path)
+{
+    JSGlobalData& globalData = *toJS(group);
+    APIEntryShim entryShim(&globalData);
+    return globalData.codeCache()->loadBytecodeCache(path);
+}
+
+bool JSContextGroupWriteBytecodeCache(JSContextGroupRef group, const char* path)
+{
+    JSGlobalData& globalData = *toJS(group);
+    APIEntryShim entryShim(&globalData);
+    return globalData.codeCache()->writeBytecodeCache(globalData, path);
+}
+
 // From the API's perspective, a global context remains alive iff it has been JSGlobalContextRetained.
 
 JSGlobalContextRef JSGlobalContextCreate(JSClassRef globalObjectClass)
@@ -54,6 +54,47 @@ JS_EXPORT JSGlobalContextRef JSContextGetGlobalContext(JSContextRef ctx);
 @result A string containing the backtrace
 */
 JS_EXPORT JSStringRef JSContextCreateBacktrace(JSContextRef ctx, unsigned maxStackSize) AVAILABLE_IN_WEBKIT_VERSION_4_0;
+
+/*!
+@typedef JSHeapSizeLimitCallback
+@abstract The callback invoked when a context group's heap stays over its size limit.
+@param group The context group whose heap is over its limit.
+@param ctx The global context of the JavaScript that was allocating, or NULL if none was running. It has a pending out-of-memory exception.
+@param context User specified context data previously passed to JSContextGroupSetHeapSizeLimit.
+@discussion The callback is invoked each time the out-of-memory error is thrown, just before it reaches the JavaScript. It may, for example, schedule ctx to be released.
+*/
+typedef void (*JSHeapSizeLimitCallback)(JSContextGroupRef group, JSContextRef ctx, void* context);
+
+/*!
+@function
+@abstract Sets a limit on the size of the heap of a context group.
+@param group The JSContextGroup whose heap to limit.
+@param limit The limit in bytes, or 0 to remove the limit.
+@param callback The callback to invoke when the limit is exceeded. May be NULL.
+@param context User data to pass to the callback.
+@discussion Allocation past the limit forces a garbage collection. If that does not bring the heap back under the limit, the running JavaScript throws an out-of-memory error the next time it leaves optimized code for the runtime. The error can be caught; the heap may then grow by a sixteenth of the limit before the next collection is forced, so that the script can recover by dropping what it holds on to.
+*/
+JS_EXPORT void JSContextGroupSetHeapSizeLimit(JSContextGroupRef group, size_t limit, JSHeapSizeLimitCallback callback, void* context) AVAILABLE_IN_WEBKIT_VERSION_4_0;
+
+/*!
+@function
+@abstract Loads a bytecode cache file written by JSContextGroupWriteBytecodeCache.
+@param group The JSContextGroup that should use the file.
+@param path The path of the file.
+@result true if the file was loaded, otherwise false.
+@discussion Scripts evaluated in the group whose source text is in the file skip parsing and bytecode generation. The file replaces any file loaded before. A file written by a different version of JavaScriptCore is ignored, as is one that is damaged.
+*/
+JS_EXPORT bool JSContextGroupLoadBytecodeCache(JSContextGroupRef group, const char* path) AVAILABLE_IN_WEBKIT_VERSION_4_0;
+
+/*!
+@function
+@abstract Writes the bytecode of the scripts that a context group has evaluated to a file.
+@param group The JSContextGroup whose bytecode to write.
+@param path The path of the file to write.
+@result true if the file was written, otherwise false.
+@discussion Scripts evaluated with a debugger or profiler attached, and eval code, are not written.
+*/
+JS_EXPORT bool JSContextGroupWriteBytecodeCache(JSContextGroupRef group, const char* path) AVAILABLE_IN_WEBKIT_VERSION_4_0;
     
 #ifdef __cplusplus
 }
@@ -1022,6 +1022,187 @@ static bool checkForCycleInPrototypeChain()
     return result;
 }
 
+static bool checkGarbageCollectionStatistics()
+{
+    static const JSGarbageCollectionPhase phasesOfFullCollections[] = {
+        kJSGarbageCollectionPhaseRootMarking,
+        kJSGarbageCollectionPhaseConservativeScan,
+        kJSGarbageCollectionPhaseWeakHarvesting,
+        kJSGarbageCollectionPhaseCopying,
+        kJSGarbageCollectionPhaseSweeping
+    };
+    bool result = true;
+    JSGlobalContextRef context = JSGlobalContextCreate(0);
+    JSGarbageCollectionPhaseStatistics collection;
+    JSGarbageCollectionPhaseStatistics statistics;
+    unsigned i;
+
+    JSResetGarbageCollectionStatistics(context);
+    JSGetGarbageCollectionPhaseStatistics(context, kJSGarbageCollectionPhaseCollection, &collection);
+    result &= assertTrue(!collection.count && !collection.total, "Resetting the statistics forgets the collections");
+
+    for (i = 0; i < 3; ++i)
+        JSSynchronousGarbageCollectForDebugging(context);
+
+    result &= assertTrue(JSGetGarbageCollectionPhaseStatistics(context, kJSGarbageCollectionPhaseCollection, &collection), "The whole pause is a valid phase");
+    result &= assertTrue(collection.count == 3, "Each collection is counted once");
+    result &= assertTrue(collection.median <= collection.percentile90 && collection.percentile90 <= collection.percentile99
+                         && collection.percentile99 <= collection.maximum && collection.maximum <= collection.total, "Percentiles are ordered");
+
+    // Phases that run in several parts still count once per collection.
+    for (i = 0; i < sizeof(phasesOfFullCollections) / sizeof(phasesOfFullCollections[0]); ++i) {
+        JSGetGarbageCollectionPhaseStatistics(context, phasesOfFullCollections[i], &statistics);
+        result &= assertTrue(statistics.count == 3, "Each phase of a full collection is counted once per collection");
+        result &= assertTrue(statistics.maximum <= statistics.total && statistics.total <= collection.total, "A phase takes no longer than the collections");
+    }
+
+    result &= assertTrue(!JSGetGarbageCollectionPhaseStatistics(context, (JSGarbageCollectionPhase)100, &statistics), "An unknown phase is rejected");
+    result &= assertTrue(!statistics.count && !statistics.total && !statistics.maximum, "An unknown phase has no times");
+
+    JSGlobalContextRelease(context);
+    return result;
+}
+
+static unsigned heapSizeLimitCallbackCount;
+
+static void heapSizeLimitCallback(JSContextGroupRef group, JSContextRef ctx, void* context)
+{
+    UNUSED_PARAM(group);
+    UNUSED_PARAM(context);
+    if (ctx)
+        heapSizeLimitCallbackCount++;
+}
+
+static bool checkHeapSizeLimit()
+{
+    bool result = true;
+    JSContextGroupRef group = JSContextGroupCreate();
+    JSGlobalContextRef context = JSGlobalContextCreateInGroup(group, 0);
+    JSStringRef code;
+    JSValueRef value;
+    JSValueRef exception = 0;
+
+    heapSizeLimitCallbackCount = 0;
+    JSContextGroupSetHeapSizeLimit(group, 8 * 1024 * 1024, heapSizeLimitCallback, 0);
+
+    // The loop keeps everything it allocates alive, so only the error ends it.
+    code = JSStringCreateWithUTF8CString("var held = []; var caught = false;"
+                                         "try { for (var i = 0; i < 200000; ++i) held.push(new Array(100)); } catch (e) { caught = e instanceof Error; }"
+                                         "held = null; caught");
+    value = JSEvaluateScript(context, code, /* thisObject*/ 0, /* sourceURL */ 0, 1, &exception);
+    JSStringRelease(code);
+    result &= assertTrue(!exception && value && JSValueToBoolean(context, value), "The script catches the out-of-memory error");
+    result &= assertTrue(heapSizeLimitCallbackCount >= 1, "The callback is told about the error");
+
+    JSSynchronousGarbageCollectForDebugging(context);
+    exception = 0;
+    code = JSStringCreateWithUTF8CString("var sum = 0; for (var i = 0; i < 1000; ++i) sum += [i, i].length; sum");
+    value = JSEvaluateScript(context, code, /* thisObject*/ 0, /* sourceURL */ 0, 1, &exception);
+    JSStringRelease(code);
+    result &= assertTrue(!exception && value && JSValueToNumber(context, value, 0) == 2000, "Scripts run after the heap went back under its limit");
+
+    JSContextGroupSetHeapSizeLimit(group, 0, 0, 0);
+    JSGlobalContextRelease(context);
+    JSContextGroupRelease(group);
+    return result;
+}
+
+static const char* bytecodeCachePath = "testapi-bytecode-cache";
+static const char* bytecodeCacheScript = "function fib(n) { return n < 2 ? n : fib(n - 1) + fib(n - 2); }\n"
+                                         "var lazy = { twice: function(x) { return x * 2; } };";
+
+// Evaluates script in a new context group, then calls the functions it defines,
+// which are only decoded from the cache when called. Returns -1 on an exception.
+static double evaluateWithBytecodeCache(const char* script, bool (*cacheFunction)(JSContextGroupRef, const char*), bool* cacheResult)
+{
+    JSContextGroupRef group = JSContextGroupCreate();
+    JSGlobalContextRef context;
+    JSStringRef code;
+    JSValueRef value;
+    double result = -1;
+
+    if (cacheFunction == JSContextGroupLoadBytecodeCache)
+        *cacheResult = JSContextGroupLoadBytecodeCache(group, bytecodeCachePath);
+    context = JSGlobalContextCreateInGroup(group, 0);
+    code = JSStringCreateWithUTF8CString(script);
+    if (JSEvaluateScript(context, code, /* thisObject*/ 0, /* sourceURL */ 0, 1, 0)) {
+        JSStringRef call = JSStringCreateWithUTF8CString("lazy.twice(fib(10))");
+        if ((value = JSEvaluateScript(context, call, /* thisObject*/ 0, /* sourceURL */ 0, 1, 0)))
+            result = JSValueToNumber(context, value, 0);
+        JSStringRelease(call);
+    }
+    JSStringRelease(code);
+    if (cacheFunction == JSContextGroupWriteBytecodeCache)
+        *cacheResult = JSContextGroupWriteBytecodeCache(group, bytecodeCachePath);
+
+    JSGlobalContextRelease(context);
+    JSContextGroupRelease(group);
+    return result;
+}
+
+// Flips a byte of the cache file, at offset or, if offset is 0, in the middle of its data.
+static bool damageBytecodeCache(long offset)
+{
+    FILE* file = fopen(bytecodeCachePath, "r+b");
+    uint32_t dataLocation[2];
+    int byte;
+    bool result = false;
+
+    if (!file)
+        return false;
+    if (!offset && !fseek(file, 20, SEEK_SET) && fread(dataLocation, sizeof(dataLocation), 1, file) == 1)
+        offset = dataLocation[0] + dataLocation[1] / 2;
+    if (offset && !fseek(file, offset, SEEK_SET) && (byte = fgetc(file)) != EOF && !fseek(file, offset, SEEK_SET))
+        result = fputc(byte ^ 0xff, file) != EOF;
+    if (fclose(file))
+        result = false;
+    return result;
+}
+
+static bool checkBytecodeCache()
+{
+    bool result = true;
+    bool cacheResult = false;
+
+    result &= assertTrue(evaluateWithBytecodeCache(bytecodeCacheScript, JSContextGroupWriteBytecodeCache, &cacheResult) == 110, "Scripts run before the cache is written");
+    result &= assertTrue(cacheResult, "The cache is written");
+
+    // The group that has the file loaded, and mapped, writes it again.
+    cacheResult = false;
+    result &= assertTrue(evaluateWithBytecodeCache(bytecodeCacheScript, JSContextGroupLoadBytecodeCache, &cacheResult) == 110, "Scripts run from the cache");
+    result &= assertTrue(cacheResult, "The cache is loaded");
+    cacheResult = false;
+    JSContextGroupRef group = JSContextGroupCreate();
+    JSContextGroupLoadBytecodeCache(group, bytecodeCachePath);
+    JSGlobalContextRef context = JSGlobalContextCreateInGroup(group, 0);
+    JSStringRef code = JSStringCreateWithUTF8CString(bytecodeCacheScript);
+    JSEvaluateScript(context, code, /* thisObject*/ 0, /* sourceURL */ 0, 1, 0);
+    JSStringRelease(code);
+    result &= assertTrue(JSContextGroupWriteBytecodeCache(group, bytecodeCachePath), "A loaded cache can be written over");
+    result &= assertTrue(evaluateWithBytecodeCache(bytecodeCacheScript, JSContextGroupLoadBytecodeCache, &cacheResult) == 110 && cacheResult, "Scripts run from a cache written over a loaded one");
+    JSGlobalContextRelease(context);
+    JSContextGroupRelease(group);
+
+    cacheResult = false;
+    result &= assertTrue(evaluateWithBytecodeCache("function fib(n) { return n; }\n"
+                                                   "var lazy = { twice: function(x) { return x * 3; } };", JSContextGroupLoadBytecodeCache, &cacheResult) == 30, "A cache is not used for a different source");
+    result &= assertTrue(cacheResult, "The cache is loaded");
+
+    // Data is only checked when it is used, so a damaged entry loads but is parsed again.
+    cacheResult = false;
+    result &= assertTrue(damageBytecodeCache(0), "The cache data can be damaged");
+    result &= assertTrue(evaluateWithBytecodeCache(bytecodeCacheScript, JSContextGroupLoadBytecodeCache, &cacheResult) == 110, "Scripts run with a cache whose checksum fails");
+    result &= assertTrue(cacheResult, "A cache with damaged data is loaded");
+
+    cacheResult = true;
+    result &= assertTrue(damageBytecodeCache(1), "The cache header can be damaged");
+    result &= assertTrue(evaluateWithBytecodeCache(bytecodeCacheScript, JSContextGroupLoadBytecodeCache, &cacheResult) == 110, "Scripts run with a cache that is not loaded");
+    result &= assertTrue(!cacheResult, "A cache with a damaged header is not loaded");
+
+    remove(bytecodeCachePath);
+    return result;
+}
+
 static void checkConstnessInJSObjectNames()
 {
     JSStaticFunction fun;
@@ -1675,6 +1856,27 @@ int main(int argc, char* argv[])
         failed = true;
     }
 
+    if (checkGarbageCollectionStatistics())
+        printf("PASS: Garbage collection phases are counted once per collection.\n");
+    else {
+        printf("FAIL: Garbage collection phase statistics are wrong.\n");
+        failed = true;
+    }
+
+    if (checkHeapSizeLimit())
+        printf("PASS: Scripts can catch and recover from the heap size limit error.\n");
+    else {
+        printf("FAIL: The heap size limit error is not recoverable.\n");
+        failed = true;
+    }
+
+    if (checkBytecodeCache())
+        printf("PASS: Scripts run the same from a bytecode cache.\n");
+    else {
+        printf("FAIL: Scripts run differently from a bytecode cache.\n");
+        failed = true;
+    }
+
     if (failed) {
         printf("FAIL: Some tests failed.\n");
         return 1;
@@ -73,6 +73,7 @@ SOURCES += \
     bytecode/SpeculatedType.cpp \
     bytecode/StructureStubClearingWatchpoint.cpp \
     bytecode/StructureStubInfo.cpp \
+    bytecode/TierUpStatistics.cpp \
     bytecode/UnlinkedCodeBlock.cpp \
     bytecode/Watchpoint.cpp \
     bytecompiler/BytecodeGenerator.cpp \
@@ -86,10 +87,14 @@ SOURCES += \
     heap/WeakBlock.cpp \
     heap/HandleSet.cpp \
     heap/HandleStack.cpp \
+    heap/AllocationSiteProfiler.cpp \
+    heap/BackgroundSweeper.cpp \
     heap/BlockAllocator.cpp \
+    heap/GCPauseStatistics.cpp \
     heap/GCThreadSharedData.cpp \
     heap/GCThread.cpp \
     heap/Heap.cpp \
+    heap/HeapSnapshotBuilder.cpp \
     heap/HeapStatistics.cpp \
     heap/HeapTimer.cpp \
     heap/IncrementalSweeper.cpp \
@@ -109,6 +114,7 @@ SOURCES += \
     dfg/DFGArgumentsSimplificationPhase.cpp \
     dfg/DFGArrayMode.cpp \
     dfg/DFGAssemblyHelpers.cpp \
+    dfg/DFGBoundsCheckEliminationPhase.cpp \
     dfg/DFGByteCodeParser.cpp \
     dfg/DFGCapabilities.cpp \
     dfg/DFGCFAPhase.cpp \
@@ -131,6 +137,7 @@ SOURCES += \
     dfg/DFGOSRExitCompiler64.cpp \
     dfg/DFGOSRExitCompiler32_64.cpp \
     dfg/DFGPhase.cpp \
+    dfg/DFGPlan.cpp \
     dfg/DFGPredictionPropagationPhase.cpp \
     dfg/DFGRepatch.cpp \
     dfg/DFGSpeculativeJIT.cpp \
@@ -193,6 +200,7 @@ SOURCES += \
     runtime/BooleanConstructor.cpp \
     runtime/BooleanObject.cpp \
     runtime/BooleanPrototype.cpp \
+    runtime/BytecodeCache.cpp \
     runtime/CallData.cpp \
     runtime/CodeCache.cpp \
     runtime/CodeSpecializationKind.cpp \
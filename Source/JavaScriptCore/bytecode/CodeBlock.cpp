@@ -64,7 +64,7 @@ using namespace DFG;
 
 CodeBlockHash CodeBlock::hash() const
 {
-    return CodeBlockHash(ownerExecutable()->source(), specializationKind());
+    return ownerExecutable()->hashFor(specializationKind());
 }
 
 void CodeBlock::dumpAssumingJITType(PrintStream& out, JITCode::JITType jitType) const
@@ -1920,6 +1920,9 @@ CodeBlock::~CodeBlock()
     // Remove myself from the set of DFG code blocks. Note that I may not be in this set
     // (because I'm not a DFG code block), in which case this is a no-op anyway.
     m_globalData->heap.m_dfgCodeBlocks.m_set.remove(this);
+    
+    if (getJITType() == JITCode::DFGJIT)
+        m_globalData->tierUpStatistics.willDestroyOptimizedCodeBlock(this);
 #endif
     
 #if ENABLE(VERBOSE_VALUE_PROFILE)
@@ -2244,6 +2247,7 @@ void CodeBlock::finalizeUnconditionally()
             }
         }
         
+        m_globalData->tierUpStatistics.didJettison(alternative(), TierUpStatistics::JettisonDueToDeadWeakReferences);
         jettison();
         return;
     }
@@ -2791,7 +2795,7 @@ void CodeBlock::copyPostParseDataFromAlternative()
 }
 
 #if ENABLE(JIT)
-void CodeBlock::reoptimize()
+void CodeBlock::reoptimize(TierUpStatistics::JettisonReason reason)
 {
     ASSERT(replacement() != this);
     ASSERT(replacement()->alternative() == this);
@@ -2800,6 +2804,7 @@ void CodeBlock::reoptimize()
         dataLog(*replacement(), " will be jettisoned due to reoptimization of ", *this, ".\n");
     replacement()->jettison();
     countReoptimization();
+    m_globalData->tierUpStatistics.didJettison(this, reason);
     optimizeAfterWarmUp();
 }
 
@@ -65,6 +65,7 @@
 #include "RegExpObject.h"
 #include "ResolveOperation.h"
 #include "StructureStubInfo.h"
+#include "TierUpStatistics.h"
 #include "UnconditionalFinalizer.h"
 #include "ValueProfile.h"
 #include "Watchpoint.h"
@@ -1163,7 +1164,7 @@ namespace JSC {
 #endif
         
 #if ENABLE(JIT)
-        void reoptimize();
+        void reoptimize(TierUpStatistics::JettisonReason);
 #endif
 
 #if ENABLE(VERBOSE_VALUE_PROFILE)
@@ -0,0 +1,328 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "TierUpStatistics.h"
+
+#include "CodeBlock.h"
+#include "Executable.h"
+#include "JSGlobalData.h"
+#include "JSONObject.h"
+#include "Options.h"
+#include <algorithm>
+#include <wtf/CurrentTime.h>
+#include <wtf/StringPrintStream.h>
+#include <wtf/text/StringBuilder.h>
+
+namespace JSC {
+
+static inline uint64_t keyFor(CodeBlock* codeBlock)
+{
+    return static_cast<uint64_t>(codeBlock->hash().hash()) + 1;
+}
+
+TierUpStatistics::ExitCounts::ExitCounts()
+{
+    for (unsigned i = 0; i < numberOfExitKinds; ++i)
+        byKind[i] = 0;
+}
+
+void TierUpStatistics::ExitCounts::add(const ExitCounts& other)
+{
+    for (unsigned i = 0; i < numberOfExitKinds; ++i)
+        byKind[i] += other.byKind[i];
+    for (HashMap<uint64_t, uint64_t>::const_iterator iter = other.bySite.begin(); iter != other.bySite.end(); ++iter)
+        bySite.add(iter->key, 0).iterator->value += iter->value;
+}
+
+void TierUpStatistics::ExitCounts::add(CodeBlock* codeBlock)
+{
+#if ENABLE(DFG_JIT)
+    ASSERT(codeBlock->getJITType() == JITCode::DFGJIT);
+    for (unsigned i = 0; i < codeBlock->numberOfOSRExits(); ++i) {
+        DFG::OSRExit& exit = codeBlock->osrExit(i);
+        if (!exit.m_count)
+            continue;
+        ASSERT(static_cast<unsigned>(exit.m_kind) < numberOfExitKinds);
+        byKind[exit.m_kind] += exit.m_count;
+        
+        // Exits from inlined code are attributed to the call site in the machine
+        // code block.
+        CodeOrigin codeOrigin = exit.m_codeOrigin;
+        while (codeOrigin.inlineCallFrame)
+            codeOrigin = codeOrigin.inlineCallFrame->caller;
+        uint64_t siteKey = ((static_cast<uint64_t>(codeOrigin.bytecodeIndex) << 4) | exit.m_kind) + 1;
+        bySite.add(siteKey, 0).iterator->value += exit.m_count;
+    }
+#else
+    UNUSED_PARAM(codeBlock);
+#endif
+}
+
+TierUpStatistics::Record::Record(CodeBlock* codeBlock)
+    : baselineCompiles(0)
+    , baselineCompileTime(0)
+    , baselineTime(-1)
+    , optimizedCompiles(0)
+    , failedOptimizedCompiles(0)
+    , optimizedCompileTime(0)
+    , optimizedTime(-1)
+    , reoptimizations(0)
+{
+    hash = toCString(codeBlock->hash()).data();
+    StringPrintStream codeTypeStream;
+    codeTypeStream.print(codeBlock->codeType());
+    if (codeBlock->codeType() == FunctionCode) {
+        codeTypeStream.print(codeBlock->specializationKind());
+        name = static_cast<FunctionExecutable*>(codeBlock->ownerExecutable())->inferredName().string();
+    }
+    codeType = codeTypeStream.toCString().data();
+    for (unsigned i = 0; i < NumberOfJettisonReasons; ++i)
+        jettisons[i] = 0;
+}
+
+TierUpStatistics::TierUpStatistics()
+    : m_droppedRecords(0)
+    , m_startTime(WTF::monotonicallyIncreasingTime())
+{
+}
+
+TierUpStatistics::~TierUpStatistics()
+{
+}
+
+double TierUpStatistics::now() const
+{
+    return WTF::monotonicallyIncreasingTime() - m_startTime;
+}
+
+TierUpStatistics::Record* TierUpStatistics::recordFor(CodeBlock* codeBlock)
+{
+    if (!Options::recordTierUpStatistics())
+        return 0;
+    uint64_t key = keyFor(codeBlock);
+    if (m_records.size() >= Options::maximumTierUpStatisticsRecords()) {
+        RecordMap::iterator iter = m_records.find(key);
+        if (iter == m_records.end()) {
+            m_droppedRecords++;
+            return 0;
+        }
+        return iter->value.get();
+    }
+    RecordMap::AddResult result = m_records.add(key, nullptr);
+    if (result.isNewEntry)
+        result.iterator->value = adoptPtr(new Record(codeBlock));
+    return result.iterator->value.get();
+}
+
+void TierUpStatistics::didCompile(CodeBlock* codeBlock, double seconds)
+{
+    Record* record = recordFor(codeBlock);
+    if (!record)
+        return;
+    if (JITCode::isOptimizingJIT(codeBlock->getJITType())) {
+        if (!record->optimizedCompiles)
+            record->optimizedTime = now();
+        record->optimizedCompiles++;
+        record->optimizedCompileTime += seconds;
+        return;
+    }
+    if (!record->baselineCompiles)
+        record->baselineTime = now();
+    record->baselineCompiles++;
+    record->baselineCompileTime += seconds;
+}
+
+void TierUpStatistics::didFailToOptimize(CodeBlock* baselineCodeBlock, double seconds)
+{
+    Record* record = recordFor(baselineCodeBlock);
+    if (!record)
+        return;
+    record->failedOptimizedCompiles++;
+    record->optimizedCompileTime += seconds;
+}
+
+void TierUpStatistics::didJettison(CodeBlock* baselineCodeBlock, JettisonReason reason)
+{
+    Record* record = recordFor(baselineCodeBlock);
+    if (!record)
+        return;
+    record->jettisons[reason]++;
+    record->reoptimizations = std::max(record->reoptimizations, baselineCodeBlock->reoptimizationRetryCounter());
+}
+
+void TierUpStatistics::willDestroyOptimizedCodeBlock(CodeBlock* codeBlock)
+{
+    if (m_records.isEmpty())
+        return;
+    RecordMap::iterator iter = m_records.find(keyFor(codeBlock));
+    if (iter == m_records.end())
+        return;
+    iter->value->exits.add(codeBlock);
+}
+
+void TierUpStatistics::clear()
+{
+    m_records.clear();
+    m_droppedRecords = 0;
+    m_startTime = WTF::monotonicallyIncreasingTime();
+}
+
+const char* TierUpStatistics::jettisonReasonName(JettisonReason reason)
+{
+    switch (reason) {
+    case JettisonDueToOSRExits:
+        return "OSRExits";
+    case JettisonDueToLoopOSRExits:
+        return "LoopOSRExits";
+    case JettisonDueToOSREntryFailures:
+        return "OSREntryFailures";
+    case JettisonDueToDeadWeakReferences:
+        return "DeadWeakReferences";
+    default:
+        ASSERT_NOT_REACHED();
+        return 0;
+    }
+}
+
+static void appendMilliseconds(StringBuilder& builder, double seconds)
+{
+    builder.append(String::numberToStringECMAScript(seconds * 1000));
+}
+
+String TierUpStatistics::toJSON(JSGlobalData& globalData) const
+{
+    // The exits from optimized code that has not been destroyed yet, jettisoned
+    // or not, are added to those that have been recorded.
+    HashMap<uint64_t, ExitCounts> liveExits;
+#if ENABLE(DFG_JIT)
+    const HashSet<CodeBlock*>& codeBlocks = globalData.heap.dfgCodeBlocks().codeBlocks();
+    for (HashSet<CodeBlock*>::const_iterator iter = codeBlocks.begin(); iter != codeBlocks.end(); ++iter) {
+        if ((*iter)->getJITType() != JITCode::DFGJIT || !m_records.contains(keyFor(*iter)))
+            continue;
+        liveExits.add(keyFor(*iter), ExitCounts()).iterator->value.add(*iter);
+    }
+#else
+    UNUSED_PARAM(globalData);
+#endif
+    
+    Vector<uint64_t> keys;
+    for (RecordMap::const_iterator iter = m_records.begin(); iter != m_records.end(); ++iter)
+        keys.append(iter->key);
+    std::sort(keys.begin(), keys.end());
+    
+    StringBuilder builder;
+    builder.appendLiteral("{\"elapsedTime\":");
+    appendMilliseconds(builder, now());
+    builder.appendLiteral(",\"droppedCodeBlocks\":");
+    builder.appendNumber(m_droppedRecords);
+    builder.appendLiteral(",\"codeBlocks\":[");
+    for (unsigned i = 0; i < keys.size(); ++i) {
+        const Record& record = *m_records.get(keys[i]);
+        ExitCounts exits;
+        exits.add(record.exits);
+        HashMap<uint64_t, ExitCounts>::const_iterator live = liveExits.find(keys[i]);
+        if (live != liveExits.end())
+            exits.add(live->value);
+        
+        if (i)
+            builder.append(',');
+        builder.appendLiteral("{\"hash\":");
+        appendQuotedJSONString(builder, record.hash);
+        builder.appendLiteral(",\"codeType\":");
+        appendQuotedJSONString(builder, record.codeType);
+        builder.appendLiteral(",\"name\":");
+        appendQuotedJSONString(builder, record.name);
+        builder.appendLiteral(",\"baselineTime\":");
+        if (record.baselineCompiles)
+            appendMilliseconds(builder, record.baselineTime);
+        else
+            builder.appendLiteral("null");
+        builder.appendLiteral(",\"baselineCompiles\":");
+        builder.appendNumber(record.baselineCompiles);
+        builder.appendLiteral(",\"baselineCompileTime\":");
+        appendMilliseconds(builder, record.baselineCompileTime);
+        builder.appendLiteral(",\"optimizedTime\":");
+        if (record.optimizedCompiles)
+            appendMilliseconds(builder, record.optimizedTime);
+        else
+            builder.appendLiteral("null");
+        builder.appendLiteral(",\"optimizedCompiles\":");
+        builder.appendNumber(record.optimizedCompiles);
+        builder.appendLiteral(",\"failedOptimizedCompiles\":");
+        builder.appendNumber(record.failedOptimizedCompiles);
+        builder.appendLiteral(",\"optimizedCompileTime\":");
+        appendMilliseconds(builder, record.optimizedCompileTime);
+        builder.appendLiteral(",\"reoptimizations\":");
+        builder.appendNumber(record.reoptimizations);
+        
+        builder.appendLiteral(",\"jettisons\":{");
+        for (unsigned reason = 0; reason < NumberOfJettisonReasons; ++reason) {
+            if (reason)
+                builder.append(',');
+            builder.append('"');
+            builder.append(jettisonReasonName(static_cast<JettisonReason>(reason)));
+            builder.appendLiteral("\":");
+            builder.appendNumber(record.jettisons[reason]);
+        }
+        
+        builder.appendLiteral("},\"osrExits\":{");
+        bool first = true;
+        for (unsigned kind = 0; kind < numberOfExitKinds; ++kind) {
+            if (!exits.byKind[kind])
+                continue;
+            if (!first)
+                builder.append(',');
+            first = false;
+            builder.append('"');
+            builder.append(DFG::exitKindToString(static_cast<DFG::ExitKind>(kind)));
+            builder.appendLiteral("\":");
+            builder.appendNumber(static_cast<unsigned long long>(exits.byKind[kind]));
+        }
+        
+        Vector<uint64_t> siteKeys;
+        for (HashMap<uint64_t, uint64_t>::const_iterator iter = exits.bySite.begin(); iter != exits.bySite.end(); ++iter)
+            siteKeys.append(iter->key);
+        std::sort(siteKeys.begin(), siteKeys.end());
+        builder.appendLiteral("},\"osrExitSites\":[");
+        for (unsigned j = 0; j < siteKeys.size(); ++j) {
+            uint64_t site = siteKeys[j] - 1;
+            if (j)
+                builder.append(',');
+            builder.appendLiteral("{\"bytecodeIndex\":");
+            builder.appendNumber(static_cast<unsigned>(site >> 4));
+            builder.appendLiteral(",\"kind\":\"");
+            builder.append(DFG::exitKindToString(static_cast<DFG::ExitKind>(site & 0xf)));
+            builder.appendLiteral("\",\"count\":");
+            builder.appendNumber(static_cast<unsigned long long>(exits.bySite.get(siteKeys[j])));
+            builder.append('}');
+        }
+        builder.appendLiteral("]}");
+    }
+    builder.appendLiteral("]}");
+    return builder.toString();
+}
+
+} // namespace JSC
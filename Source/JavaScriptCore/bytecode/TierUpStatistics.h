@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef TierUpStatistics_h
+#define TierUpStatistics_h
+
+#include "DFGExitProfile.h"
+#include <wtf/HashMap.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/text/WTFString.h>
+
+namespace JSC {
+
+class CodeBlock;
+class JSGlobalData;
+
+// Records, for each CodeBlockHash, when its code moved up a tier, how long
+// compiling it took, why its optimized code was thrown away, and where that
+// code exited to the baseline JIT. Nothing is recorded while code runs, only
+// when it is compiled, jettisoned or destroyed. Recording is off unless
+// Options::recordTierUpStatistics() is set, and stops taking new code blocks
+// once Options::maximumTierUpStatisticsRecords() of them are recorded. Times
+// are in seconds.
+class TierUpStatistics {
+    WTF_MAKE_NONCOPYABLE(TierUpStatistics);
+public:
+    enum JettisonReason {
+        JettisonDueToOSRExits, // The optimized code exited too often.
+        JettisonDueToLoopOSRExits, // The same, noticed when a loop asked to be optimized.
+        JettisonDueToOSREntryFailures, // Entering the optimized code from a loop kept failing.
+        JettisonDueToDeadWeakReferences, // The optimized code assumed an object that was collected.
+        NumberOfJettisonReasons
+    };
+    
+    TierUpStatistics();
+    ~TierUpStatistics();
+    
+    void didCompile(CodeBlock*, double seconds);
+    void didFailToOptimize(CodeBlock* baselineCodeBlock, double seconds);
+    void didJettison(CodeBlock* baselineCodeBlock, JettisonReason);
+    
+    // Counts the OSR exits taken from optimized code that is going away. The
+    // exits from optimized code that is still around are counted by toJSON().
+    void willDestroyOptimizedCodeBlock(CodeBlock*);
+    
+    JS_EXPORT_PRIVATE String toJSON(JSGlobalData&) const;
+    JS_EXPORT_PRIVATE void clear();
+    
+    static const char* jettisonReasonName(JettisonReason);
+    
+private:
+    static const unsigned numberOfExitKinds = DFG::UncountableWatchpoint + 1;
+    
+    struct ExitCounts {
+        ExitCounts();
+        void add(const ExitCounts&);
+        void add(CodeBlock* optimizedCodeBlock);
+        
+        uint64_t byKind[numberOfExitKinds];
+        // Keyed by the bytecode index and the kind of the exit, plus one.
+        HashMap<uint64_t, uint64_t> bySite;
+    };
+    
+    struct Record {
+        Record(CodeBlock*);
+        
+        String hash;
+        String codeType;
+        String name;
+        unsigned baselineCompiles;
+        double baselineCompileTime;
+        double baselineTime;
+        unsigned optimizedCompiles;
+        unsigned failedOptimizedCompiles;
+        double optimizedCompileTime;
+        double optimizedTime;
+        unsigned reoptimizations;
+        unsigned jettisons[NumberOfJettisonReasons];
+        ExitCounts exits;
+    };
+    
+    // Keyed by the CodeBlockHash plus one, which may be zero.
+    typedef HashMap<uint64_t, OwnPtr<Record> > RecordMap;
+    
+    Record* recordFor(CodeBlock*);
+    double now() const;
+    
+    RecordMap m_records;
+    unsigned m_droppedRecords;
+    double m_startTime;
+};
+
+} // namespace JSC
+
+#endif // TierUpStatistics_h
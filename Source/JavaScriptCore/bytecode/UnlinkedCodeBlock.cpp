@@ -70,6 +70,25 @@ UnlinkedFunctionExecutable::UnlinkedFunctionExecutable(JSGlobalData* globalData,
     , m_sourceLength(node->source().length())
     , m_features(node->features())
     , m_functionNameIsInScopeToggle(node->functionNameIsInScopeToggle())
+    , m_bytecodeCacheOffsetForCall(0)
+    , m_bytecodeCacheOffsetForConstruct(0)
+{
+}
+
+UnlinkedFunctionExecutable::UnlinkedFunctionExecutable(JSGlobalData* globalData, Structure* structure)
+    : Base(*globalData, structure)
+    , m_numCapturedVariables(0)
+    , m_forceUsesArguments(false)
+    , m_isInStrictContext(false)
+    , m_hasCapturedVariables(false)
+    , m_firstLineOffset(0)
+    , m_lineCount(0)
+    , m_startOffset(0)
+    , m_sourceLength(0)
+    , m_features(0)
+    , m_functionNameIsInScopeToggle(FunctionNameIsNotInScope)
+    , m_bytecodeCacheOffsetForCall(0)
+    , m_bytecodeCacheOffsetForConstruct(0)
 {
 }
 
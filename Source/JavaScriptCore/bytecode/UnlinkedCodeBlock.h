@@ -26,6 +26,7 @@
 #ifndef UnlinkedCodeBlock_h
 #define UnlinkedCodeBlock_h
 
+#include "BytecodeCache.h"
 #include "BytecodeConventions.h"
 #include "CodeSpecializationKind.h"
 #include "CodeType.h"
@@ -76,6 +77,8 @@ struct ExecutableInfo {
 
 class UnlinkedFunctionExecutable : public JSCell {
 public:
+    friend class BytecodeCacheDecoder;
+    friend class BytecodeCacheEncoder;
     friend class CodeCache;
     typedef JSCell Base;
     static UnlinkedFunctionExecutable* create(JSGlobalData* globalData, const SourceCode& source, FunctionBodyNode* node)
@@ -137,6 +140,7 @@ public:
 
 private:
     UnlinkedFunctionExecutable(JSGlobalData*, Structure*, const SourceCode&, FunctionBodyNode*);
+    UnlinkedFunctionExecutable(JSGlobalData*, Structure*); // For BytecodeCacheDecoder, which fills in the rest.
     Weak<UnlinkedFunctionCodeBlock> m_codeBlockForCall;
     Weak<UnlinkedFunctionCodeBlock> m_codeBlockForConstruct;
 
@@ -160,6 +164,12 @@ private:
 
     FunctionNameIsInScopeToggle m_functionNameIsInScopeToggle;
 
+    // Where the bodies of a function read from a bytecode cache file are, if
+    // they have not been decoded yet. 0 if there is no body in the file.
+    RefPtr<BytecodeCacheFile> m_bytecodeCacheFile;
+    unsigned m_bytecodeCacheOffsetForCall;
+    unsigned m_bytecodeCacheOffsetForConstruct;
+
 protected:
     void finishCreation(JSGlobalData& globalData)
     {
@@ -226,6 +236,8 @@ struct UnlinkedInstruction {
 
 class UnlinkedCodeBlock : public JSCell {
 public:
+    friend class BytecodeCacheDecoder;
+    friend class BytecodeCacheEncoder;
     typedef JSCell Base;
     static const bool needsDestruction = true;
     static const bool hasImmortalStructure = true;
@@ -576,6 +588,7 @@ protected:
 
 class UnlinkedProgramCodeBlock : public UnlinkedGlobalCodeBlock {
 private:
+    friend class BytecodeCacheDecoder;
     friend class CodeCache;
     static UnlinkedProgramCodeBlock* create(JSGlobalData* globalData, const ExecutableInfo& info)
     {
@@ -670,6 +683,7 @@ public:
 
 class UnlinkedFunctionCodeBlock : public UnlinkedCodeBlock {
 private:
+    friend class BytecodeCacheDecoder;
     friend class CodeCache;
 
     static UnlinkedFunctionCodeBlock* create(JSGlobalData* globalData, CodeType codeType, const ExecutableInfo& info)
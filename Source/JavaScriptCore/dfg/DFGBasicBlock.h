@@ -31,6 +31,7 @@
 #include "DFGAbstractValue.h"
 #include "DFGBranchDirection.h"
 #include "DFGNode.h"
+#include "DFGOSREntry.h"
 #include "Operands.h"
 #include <wtf/OwnPtr.h>
 #include <wtf/Vector.h>
@@ -121,6 +122,10 @@ struct BasicBlock : Vector<NodeIndex, 8> {
     
     Operands<AbstractValue> valuesAtHead;
     Operands<AbstractValue> valuesAtTail;
+    
+    // Bounds checks that were removed from code that OSR entry into this block could
+    // reach without going through the comparison that made them redundant.
+    Vector<OSREntryBoundsCheck> osrEntryBoundsChecks;
 };
 
 struct UnlinkedBlock {
@@ -0,0 +1,428 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "DFGBoundsCheckEliminationPhase.h"
+
+#if ENABLE(DFG_JIT)
+
+#include "DFGBasicBlock.h"
+#include "DFGGraph.h"
+#include "DFGPhase.h"
+#include <wtf/BitVector.h>
+
+namespace JSC { namespace DFG {
+
+// Loads of the butterfly, the indexed storage and the length are already shared within a
+// block by CSE. They cannot be hoisted out of loops, because values can only flow between
+// blocks through locals. What we can do is notice when the loop condition has already
+// compared the index to the length, and drop the check in the loop body.
+class BoundsCheckEliminationPhase : public Phase {
+public:
+    BoundsCheckEliminationPhase(Graph& graph)
+        : Phase(graph, "bounds check elimination")
+    {
+    }
+    
+    bool run()
+    {
+        findGuards();
+        if (m_guards.isEmpty())
+            return false;
+        
+        computeNonNegativeLocals();
+        m_graph.m_dominators.computeIfNecessary(m_graph);
+        
+        bool changed = false;
+        for (BlockIndex blockIndex = 0; blockIndex < m_graph.m_blocks.size(); ++blockIndex) {
+            BasicBlock* block = m_graph.m_blocks[blockIndex].get();
+            if (!block)
+                continue;
+            for (unsigned indexInBlock = 0; indexInBlock < block->size(); ++indexInBlock) {
+                NodeIndex nodeIndex = block->at(indexInBlock);
+                Node& node = m_graph[nodeIndex];
+                if (!node.shouldGenerate())
+                    continue;
+                switch (node.op()) {
+                case GetByVal:
+                    changed |= eliminate(blockIndex, nodeIndex, node.child1(), node.child2());
+                    break;
+                case PutByVal:
+                    changed |= eliminate(blockIndex, nodeIndex, m_graph.varArgChild(node, 0), m_graph.varArgChild(node, 1));
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+        
+        if (changed) {
+            for (size_t operand = 0; operand < m_nonNegativeLocals.size(); ++operand) {
+                if (m_nonNegativeLocals.get(operand))
+                    m_graph.m_localsAssumedNonNegative.set(operand);
+            }
+        }
+        
+        return changed;
+    }
+    
+private:
+    // A block that ends by branching to m_successor if the local m_indexOperand is less
+    // than the length of the typed array in m_baseOperand. The successor must have no
+    // other predecessor, so that it dominates exactly the code reached through the edge.
+    struct Guard {
+        BlockIndex m_block;
+        BlockIndex m_successor;
+        NodeIndex m_indexNode;
+        NodeIndex m_baseNode;
+        int m_indexOperand;
+        int m_baseOperand;
+        Array::Type m_type;
+    };
+    
+    static bool isTypedArray(Array::Type type)
+    {
+        switch (type) {
+        case Array::Int8Array:
+        case Array::Int16Array:
+        case Array::Int32Array:
+        case Array::Uint8Array:
+        case Array::Uint8ClampedArray:
+        case Array::Uint16Array:
+        case Array::Uint32Array:
+        case Array::Float32Array:
+        case Array::Float64Array:
+            return true;
+        default:
+            return false;
+        }
+    }
+    
+    const TypedArrayDescriptor& typedArrayDescriptor(Array::Type type)
+    {
+        JSGlobalData& globalData = m_graph.m_globalData;
+        switch (type) {
+        case Array::Int8Array:
+            return globalData.int8ArrayDescriptor();
+        case Array::Int16Array:
+            return globalData.int16ArrayDescriptor();
+        case Array::Int32Array:
+            return globalData.int32ArrayDescriptor();
+        case Array::Uint8Array:
+            return globalData.uint8ArrayDescriptor();
+        case Array::Uint8ClampedArray:
+            return globalData.uint8ClampedArrayDescriptor();
+        case Array::Uint16Array:
+            return globalData.uint16ArrayDescriptor();
+        case Array::Uint32Array:
+            return globalData.uint32ArrayDescriptor();
+        case Array::Float32Array:
+            return globalData.float32ArrayDescriptor();
+        default:
+            ASSERT(type == Array::Float64Array);
+            return globalData.float64ArrayDescriptor();
+        }
+    }
+    
+    bool isUncapturedGetLocal(NodeIndex nodeIndex)
+    {
+        Node& node = m_graph[nodeIndex];
+        if (node.op() != GetLocal)
+            return false;
+        VariableAccessData* variable = node.variableAccessData();
+        return !variable->isCaptured() && !variable->isArgumentsAlias();
+    }
+    
+    void findGuards()
+    {
+        for (BlockIndex blockIndex = 0; blockIndex < m_graph.m_blocks.size(); ++blockIndex) {
+            BasicBlock* block = m_graph.m_blocks[blockIndex].get();
+            if (!block)
+                continue;
+            Node& branch = m_graph[block->last()];
+            if (branch.op() != Branch)
+                continue;
+            
+            BlockIndex successor = branch.takenBlockIndex();
+            if (successor == branch.notTakenBlockIndex() || successor == blockIndex)
+                continue;
+            if (m_graph.m_blocks[successor]->m_predecessors.size() != 1)
+                continue;
+            
+            Node& compare = m_graph[branch.child1()];
+            NodeIndex indexNodeIndex;
+            NodeIndex lengthNodeIndex;
+            switch (compare.op()) {
+            case CompareLess:
+                indexNodeIndex = compare.child1().index();
+                lengthNodeIndex = compare.child2().index();
+                break;
+            case CompareGreater:
+                indexNodeIndex = compare.child2().index();
+                lengthNodeIndex = compare.child1().index();
+                break;
+            default:
+                continue;
+            }
+            
+            Node& length = m_graph[lengthNodeIndex];
+            if (length.op() != GetArrayLength || !isTypedArray(length.arrayMode().type()))
+                continue;
+            if (!isUncapturedGetLocal(indexNodeIndex) || !isUncapturedGetLocal(length.child1().index()))
+                continue;
+            
+            Guard guard;
+            guard.m_block = blockIndex;
+            guard.m_successor = successor;
+            guard.m_indexNode = indexNodeIndex;
+            guard.m_baseNode = length.child1().index();
+            guard.m_indexOperand = m_graph[guard.m_indexNode].local();
+            guard.m_baseOperand = m_graph[guard.m_baseNode].local();
+            guard.m_type = length.arrayMode().type();
+            if (operandIsArgument(guard.m_indexOperand))
+                continue;
+            m_guards.append(guard);
+        }
+    }
+    
+    // Finds the locals that can never hold a negative number. Arguments and captured
+    // locals can be assigned from outside of this code, so they are left out. Otherwise,
+    // a local qualifies if everything that is stored into it is a non-negative constant,
+    // another such local, or a sum of those that is either computed as a double or checked
+    // for overflow. Start by assuming that all locals qualify, so that induction variables
+    // are found, and drop the ones that don't until nothing changes.
+    void computeNonNegativeLocals()
+    {
+        BitVector excluded;
+        for (NodeIndex nodeIndex = 0; nodeIndex < m_graph.size(); ++nodeIndex) {
+            Node& node = m_graph[nodeIndex];
+            if (!node.hasLocal())
+                continue;
+            int operand = node.local();
+            if (operandIsArgument(operand))
+                continue;
+            VariableAccessData* variable = node.variableAccessData();
+            if (variable->isCaptured() || variable->isArgumentsAlias() || variable->shouldUseDoubleFormat())
+                excluded.set(operand);
+            else if (node.op() == SetLocal)
+                m_nonNegativeLocals.set(operand);
+        }
+        for (size_t operand = 0; operand < excluded.size(); ++operand) {
+            if (excluded.get(operand))
+                m_nonNegativeLocals.clear(operand);
+        }
+        
+        bool changed;
+        do {
+            changed = false;
+            for (NodeIndex nodeIndex = 0; nodeIndex < m_graph.size(); ++nodeIndex) {
+                Node& node = m_graph[nodeIndex];
+                if (node.op() != SetLocal)
+                    continue;
+                int operand = node.local();
+                if (!m_nonNegativeLocals.get(operand))
+                    continue;
+                if (isNonNegative(node.child1().index()))
+                    continue;
+                m_nonNegativeLocals.clear(operand);
+                changed = true;
+            }
+        } while (changed);
+    }
+    
+    bool isNonNegative(NodeIndex nodeIndex)
+    {
+        Node& node = m_graph[nodeIndex];
+        switch (node.op()) {
+        case JSConstant:
+            return m_graph.isNumberConstant(nodeIndex) && m_graph.valueOfJSConstant(nodeIndex).asNumber() >= 0;
+            
+        case GetLocal:
+            return !operandIsArgument(node.local()) && m_nonNegativeLocals.get(node.local());
+            
+        case ArithAdd:
+            // Integer additions that may truncate wrap around instead of failing.
+            if (m_graph.addShouldSpeculateInteger(node) && nodeCanTruncateInteger(node.arithNodeFlags()))
+                return false;
+            return isNonNegative(node.child1().index()) && isNonNegative(node.child2().index());
+            
+        case BitAnd:
+            return isNonNegativeInt32Constant(node.child1().index()) || isNonNegativeInt32Constant(node.child2().index());
+            
+        default:
+            return false;
+        }
+    }
+    
+    bool isNonNegativeInt32Constant(NodeIndex nodeIndex)
+    {
+        return m_graph[nodeIndex].op() == JSConstant && m_graph.isInt32Constant(nodeIndex) && m_graph.valueOfInt32Constant(nodeIndex) >= 0;
+    }
+    
+    // Tells if the node stores to the local, or may run code that changes the length of a
+    // typed array; a call can neuter the array, which leaves it with no elements.
+    bool mayChange(Node& node, int operand)
+    {
+        if (node.op() == SetLocal && node.local() == operand)
+            return true;
+        return node.shouldGenerate() && m_graph.clobbersWorld(node);
+    }
+    
+    // Tells if the local may change in the given block, before the given node if there is
+    // one.
+    bool mayChangeBefore(BasicBlock* block, int operand, NodeIndex until)
+    {
+        for (unsigned indexInBlock = 0; indexInBlock < block->size(); ++indexInBlock) {
+            NodeIndex nodeIndex = block->at(indexInBlock);
+            if (nodeIndex == until)
+                return false;
+            if (mayChange(m_graph[nodeIndex], operand))
+                return true;
+        }
+        return false;
+    }
+    
+    bool mayChangeAfter(BasicBlock* block, int operand, NodeIndex from)
+    {
+        bool found = false;
+        for (unsigned indexInBlock = 0; indexInBlock < block->size(); ++indexInBlock) {
+            NodeIndex nodeIndex = block->at(indexInBlock);
+            if (nodeIndex == from) {
+                found = true;
+                continue;
+            }
+            if (found && mayChange(m_graph[nodeIndex], operand))
+                return true;
+        }
+        return false;
+    }
+    
+    // Tells if the local, or the length of the array, may have changed on some path from
+    // the guard's comparison to the access. Every block on such a path is dominated by the
+    // guard's successor, since the successor dominates the access's block.
+    bool mayChangeBetween(const Guard& guard, NodeIndex guardGetLocal, int operand, BlockIndex blockIndex, NodeIndex access)
+    {
+        if (mayChangeAfter(m_graph.m_blocks[guard.m_block].get(), operand, guardGetLocal))
+            return true;
+        
+        for (BlockIndex otherBlockIndex = 0; otherBlockIndex < m_graph.m_blocks.size(); ++otherBlockIndex) {
+            if (otherBlockIndex == blockIndex)
+                continue;
+            BasicBlock* otherBlock = m_graph.m_blocks[otherBlockIndex].get();
+            if (!otherBlock || !m_graph.m_dominators.dominates(guard.m_successor, otherBlockIndex))
+                continue;
+            if (mayChangeBefore(otherBlock, operand, NoNode))
+                return true;
+        }
+        
+        // If the access is not in the successor itself, its block may be part of an inner
+        // loop, so what comes after the access counts too.
+        BasicBlock* block = m_graph.m_blocks[blockIndex].get();
+        if (blockIndex != guard.m_successor)
+            return mayChangeBefore(block, operand, NoNode);
+        return mayChangeBefore(block, operand, access);
+    }
+    
+    bool eliminate(BlockIndex blockIndex, NodeIndex nodeIndex, Edge baseEdge, Edge indexEdge)
+    {
+        Node& node = m_graph[nodeIndex];
+        Array::Type type = node.arrayMode().type();
+        if (!isTypedArray(type))
+            return false;
+        if (!isUncapturedGetLocal(baseEdge.index()) || !isUncapturedGetLocal(indexEdge.index()))
+            return false;
+        
+        int indexOperand = m_graph[indexEdge].local();
+        int baseOperand = m_graph[baseEdge].local();
+        if (operandIsArgument(indexOperand) || !m_nonNegativeLocals.get(indexOperand))
+            return false;
+        
+        for (unsigned i = 0; i < m_guards.size(); ++i) {
+            const Guard& guard = m_guards[i];
+            if (guard.m_indexOperand != indexOperand || guard.m_baseOperand != baseOperand || guard.m_type != type)
+                continue;
+            if (!m_graph.m_dominators.dominates(guard.m_successor, blockIndex))
+                continue;
+            if (mayChangeBetween(guard, guard.m_indexNode, indexOperand, blockIndex, nodeIndex))
+                continue;
+            if (mayChangeBetween(guard, guard.m_baseNode, baseOperand, blockIndex, nodeIndex))
+                continue;
+            
+#if DFG_ENABLE(DEBUG_PROPAGATION_VERBOSE)
+            dataLogF("Eliminating a bounds check on r%d in block #%u, guarded by the branch in block #%u.\n", indexOperand, blockIndex, guard.m_block);
+#endif
+            node.mergeFlags(NodeIndexIsInBounds);
+            noticeEliminatedCheck(guard);
+            return true;
+        }
+        return false;
+    }
+    
+    // OSR entry into the code between the guard and the access skips the comparison, so
+    // have it compare the index to the length instead.
+    void noticeEliminatedCheck(const Guard& guard)
+    {
+        const TypedArrayDescriptor& descriptor = typedArrayDescriptor(guard.m_type);
+        OSREntryBoundsCheck check;
+        check.m_indexOperand = guard.m_indexOperand;
+        check.m_baseOperand = guard.m_baseOperand;
+        check.m_classInfo = descriptor.m_classInfo;
+        check.m_lengthOffset = descriptor.m_lengthOffset;
+        
+        for (BlockIndex blockIndex = 0; blockIndex < m_graph.m_blocks.size(); ++blockIndex) {
+            BasicBlock* block = m_graph.m_blocks[blockIndex].get();
+            if (!block || !block->isOSRTarget)
+                continue;
+            if (!m_graph.m_dominators.dominates(guard.m_successor, blockIndex))
+                continue;
+            bool alreadyNoticed = false;
+            for (unsigned i = 0; i < block->osrEntryBoundsChecks.size(); ++i) {
+                const OSREntryBoundsCheck& other = block->osrEntryBoundsChecks[i];
+                if (other.m_indexOperand == check.m_indexOperand
+                    && other.m_baseOperand == check.m_baseOperand
+                    && other.m_classInfo == check.m_classInfo) {
+                    alreadyNoticed = true;
+                    break;
+                }
+            }
+            if (!alreadyNoticed)
+                block->osrEntryBoundsChecks.append(check);
+        }
+    }
+    
+    Vector<Guard> m_guards;
+    BitVector m_nonNegativeLocals;
+};
+
+bool performBoundsCheckElimination(Graph& graph)
+{
+    SamplingRegion samplingRegion("DFG Bounds Check Elimination Phase");
+    return runPhase<BoundsCheckEliminationPhase>(graph);
+}
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
+
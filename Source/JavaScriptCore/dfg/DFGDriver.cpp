@@ -32,18 +32,8 @@
 
 #if ENABLE(DFG_JIT)
 
-#include "DFGArgumentsSimplificationPhase.h"
-#include "DFGByteCodeParser.h"
-#include "DFGCFAPhase.h"
-#include "DFGCFGSimplificationPhase.h"
-#include "DFGCSEPhase.h"
-#include "DFGConstantFoldingPhase.h"
-#include "DFGFixupPhase.h"
-#include "DFGJITCompiler.h"
-#include "DFGPredictionPropagationPhase.h"
-#include "DFGStructureCheckHoistingPhase.h"
-#include "DFGValidate.h"
-#include "DFGVirtualRegisterAllocationPhase.h"
+#include "CodeBlock.h"
+#include "DFGPlan.h"
 #include "Options.h"
 
 namespace JSC { namespace DFG {
@@ -55,7 +45,6 @@ unsigned getNumCompilations()
     return numCompilations;
 }
 
-enum CompileMode { CompileFunction, CompileOther };
 inline bool compile(CompileMode compileMode, ExecState* exec, CodeBlock* codeBlock, JITCode& jitCode, MacroAssemblerCodePtr* jitCodeWithArityCheck, unsigned osrEntryBytecodeIndex)
 {
     SamplingRegion samplingRegion("DFG Compilation (Driver)");
@@ -75,92 +64,11 @@ inline bool compile(CompileMode compileMode, ExecState* exec, CodeBlock* codeBlo
     dataLogF("DFG compiling code block %p(%p) for executable %p, number of instructions = %u.\n", codeBlock, codeBlock->alternative(), codeBlock->ownerExecutable(), codeBlock->instructionCount());
 #endif
     
-    // Derive our set of must-handle values. The compilation must be at least conservative
-    // enough to allow for OSR entry with these values.
-    unsigned numVarsWithValues;
-    if (osrEntryBytecodeIndex)
-        numVarsWithValues = codeBlock->m_numVars;
-    else
-        numVarsWithValues = 0;
-    Operands<JSValue> mustHandleValues(codeBlock->numParameters(), numVarsWithValues);
-    for (size_t i = 0; i < mustHandleValues.size(); ++i) {
-        int operand = mustHandleValues.operandForIndex(i);
-        if (operandIsArgument(operand)
-            && !operandToArgument(operand)
-            && compileMode == CompileFunction
-            && codeBlock->specializationKind() == CodeForConstruct) {
-            // Ugh. If we're in a constructor, the 'this' argument may hold garbage. It will
-            // also never be used. It doesn't matter what we put into the value for this,
-            // but it has to be an actual value that can be grokked by subsequent DFG passes,
-            // so we sanitize it here by turning it into Undefined.
-            mustHandleValues[i] = jsUndefined();
-        } else
-            mustHandleValues[i] = exec->uncheckedR(operand).jsValue();
-    }
-    
-    Graph dfg(exec->globalData(), codeBlock, osrEntryBytecodeIndex, mustHandleValues);
-    if (!parse(exec, dfg))
+    RefPtr<Plan> plan = Plan::create(compileMode, codeBlock, osrEntryBytecodeIndex);
+    if (!plan->prepare(exec))
         return false;
-    
-    if (compileMode == CompileFunction)
-        dfg.predictArgumentTypes();
-    
-    // By this point the DFG bytecode parser will have potentially mutated various tables
-    // in the CodeBlock. This is a good time to perform an early shrink, which is more
-    // powerful than a late one. It's safe to do so because we haven't generated any code
-    // that references any of the tables directly, yet.
-    codeBlock->shrinkToFit(CodeBlock::EarlyShrink);
-
-    validate(dfg);
-    performPredictionPropagation(dfg);
-    performFixup(dfg);
-    performStructureCheckHoisting(dfg);
-    unsigned cnt = 1;
-    dfg.m_fixpointState = FixpointNotConverged;
-    for (;; ++cnt) {
-#if DFG_ENABLE(DEBUG_VERBOSE)
-        dataLogF("DFG beginning optimization fixpoint iteration #%u.\n", cnt);
-#endif
-        bool changed = false;
-        performCFA(dfg);
-        changed |= performConstantFolding(dfg);
-        changed |= performArgumentsSimplification(dfg);
-        changed |= performCFGSimplification(dfg);
-        changed |= performCSE(dfg);
-        if (!changed)
-            break;
-        dfg.resetExitStates();
-        performFixup(dfg);
-    }
-    dfg.m_fixpointState = FixpointConverged;
-    performCSE(dfg);
-#if DFG_ENABLE(DEBUG_VERBOSE)
-    dataLogF("DFG optimization fixpoint converged in %u iterations.\n", cnt);
-#endif
-    performVirtualRegisterAllocation(dfg);
-
-    GraphDumpMode modeForFinalValidate = DumpGraph;
-#if DFG_ENABLE(DEBUG_VERBOSE)
-    dataLogF("Graph after optimization:\n");
-    dfg.dump();
-    modeForFinalValidate = DontDumpGraph;
-#endif
-    validate(dfg, modeForFinalValidate);
-    
-    JITCompiler dataFlowJIT(dfg);
-    bool result;
-    if (compileMode == CompileFunction) {
-        ASSERT(jitCodeWithArityCheck);
-        
-        result = dataFlowJIT.compileFunction(jitCode, *jitCodeWithArityCheck);
-    } else {
-        ASSERT(compileMode == CompileOther);
-        ASSERT(!jitCodeWithArityCheck);
-        
-        result = dataFlowJIT.compile(jitCode);
-    }
-    
-    return result;
+    plan->compile();
+    return plan->finalize(jitCode, jitCodeWithArityCheck);
 }
 
 bool tryCompile(ExecState* exec, CodeBlock* codeBlock, JITCode& jitCode, unsigned bytecodeIndex)
@@ -688,6 +688,7 @@ public:
     bool m_hasArguments;
     HashSet<ExecutableBase*> m_executablesWhoseArgumentsEscaped;
     BitVector m_preservedVars;
+    BitVector m_localsAssumedNonNegative;
     Dominators m_dominators;
     unsigned m_localVars;
     unsigned m_parameterSlots;
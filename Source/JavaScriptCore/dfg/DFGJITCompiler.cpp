@@ -49,6 +49,10 @@ JITCompiler::JITCompiler(Graph& dfg)
         m_disassembler = adoptPtr(new Disassembler(dfg));
 }
 
+JITCompiler::~JITCompiler()
+{
+}
+
 void JITCompiler::linkOSRExits()
 {
     for (unsigned i = 0; i < codeBlock()->numberOfOSRExits(); ++i) {
@@ -210,31 +214,59 @@ void JITCompiler::link(LinkBuffer& linkBuffer)
     codeBlock()->shrinkToFit(CodeBlock::LateShrink);
 }
 
-bool JITCompiler::compile(JITCode& entry)
+bool JITCompiler::watchpointsAreStillValid()
+{
+    for (unsigned i = 0; i < m_watchpoints.size(); ++i) {
+        WatchpointRecord& record = m_watchpoints[i];
+        if (record.m_set ? record.m_set->hasBeenInvalidated() : record.m_inlineSet->hasBeenInvalidated())
+            return false;
+    }
+    return true;
+}
+
+void JITCompiler::addWatchpoints()
+{
+    for (unsigned i = 0; i < m_watchpoints.size(); ++i) {
+        WatchpointRecord& record = m_watchpoints[i];
+        if (record.m_set)
+            record.m_set->add(record.m_watchpoint);
+        else
+            record.m_inlineSet->add(record.m_watchpoint);
+    }
+}
+
+void JITCompiler::compile()
 {
     SamplingRegion samplingRegion("DFG Backend");
 
     setStartOfCode();
     compileEntry();
-    SpeculativeJIT speculative(*this);
-    compileBody(speculative);
+    m_speculative = adoptPtr(new SpeculativeJIT(*this));
+    compileBody(*m_speculative);
     setEndOfMainPath();
 
     // Generate slow path code.
-    speculative.runSlowPathGenerators();
+    m_speculative->runSlowPathGenerators();
     
     compileExceptionHandlers();
     linkOSRExits();
     
     // Create OSR entry trampolines if necessary.
-    speculative.createOSREntries();
+    m_speculative->createOSREntries();
     setEndOfCode();
+}
 
+bool JITCompiler::link(JITCode& entry)
+{
+    if (!watchpointsAreStillValid())
+        return false;
+    
     LinkBuffer linkBuffer(*m_globalData, this, m_codeBlock, JITCompilationCanFail);
     if (linkBuffer.didFailToAllocate())
         return false;
     link(linkBuffer);
-    speculative.linkOSREntries(linkBuffer);
+    m_speculative->linkOSREntries(linkBuffer);
+    addWatchpoints();
 
     if (m_disassembler)
         m_disassembler->dump(linkBuffer);
@@ -245,7 +277,7 @@ bool JITCompiler::compile(JITCode& entry)
     return true;
 }
 
-bool JITCompiler::compileFunction(JITCode& entry, MacroAssemblerCodePtr& entryWithArityCheck)
+void JITCompiler::compileFunction()
 {
     SamplingRegion samplingRegion("DFG Backend");
     
@@ -266,8 +298,8 @@ bool JITCompiler::compileFunction(JITCode& entry, MacroAssemblerCodePtr& entryWi
 
 
     // === Function body code generation ===
-    SpeculativeJIT speculative(*this);
-    compileBody(speculative);
+    m_speculative = adoptPtr(new SpeculativeJIT(*this));
+    compileBody(*m_speculative);
     setEndOfMainPath();
 
     // === Function footer code generation ===
@@ -284,8 +316,8 @@ bool JITCompiler::compileFunction(JITCode& entry, MacroAssemblerCodePtr& entryWi
 
     CallBeginToken token;
     beginCall(CodeOrigin(0), token);
-    Call callStackCheck = call();
-    notifyCall(callStackCheck, CodeOrigin(0), token);
+    m_callStackCheck = call();
+    notifyCall(m_callStackCheck, CodeOrigin(0), token);
     jump(fromStackCheck);
     
     // The fast entry point into a function does not check the correct number of arguments
@@ -293,7 +325,7 @@ bool JITCompiler::compileFunction(JITCode& entry, MacroAssemblerCodePtr& entryWi
     // determine the correct number of arguments have been passed, or have already checked).
     // In cases where an arity check is necessary, we enter here.
     // FIXME: change this from a cti call to a DFG style operation (normal C calling conventions).
-    Label arityCheck = label();
+    m_arityCheck = label();
     compileEntry();
 
     load32(AssemblyHelpers::payloadFor((VirtualRegister)JSStack::ArgumentCount), GPRInfo::regT1);
@@ -301,36 +333,43 @@ bool JITCompiler::compileFunction(JITCode& entry, MacroAssemblerCodePtr& entryWi
     move(stackPointerRegister, GPRInfo::argumentGPR0);
     poke(GPRInfo::callFrameRegister, OBJECT_OFFSETOF(struct JITStackFrame, callFrame) / sizeof(void*));
     beginCall(CodeOrigin(0), token);
-    Call callArityCheck = call();
-    notifyCall(callArityCheck, CodeOrigin(0), token);
+    m_callArityCheck = call();
+    notifyCall(m_callArityCheck, CodeOrigin(0), token);
     move(GPRInfo::regT0, GPRInfo::callFrameRegister);
     jump(fromArityCheck);
     
     // Generate slow path code.
-    speculative.runSlowPathGenerators();
+    m_speculative->runSlowPathGenerators();
     
     compileExceptionHandlers();
     linkOSRExits();
     
     // Create OSR entry trampolines if necessary.
-    speculative.createOSREntries();
+    m_speculative->createOSREntries();
     setEndOfCode();
+}
 
+bool JITCompiler::linkFunction(JITCode& entry, MacroAssemblerCodePtr& entryWithArityCheck)
+{
+    if (!watchpointsAreStillValid())
+        return false;
+    
     // === Link ===
     LinkBuffer linkBuffer(*m_globalData, this, m_codeBlock, JITCompilationCanFail);
     if (linkBuffer.didFailToAllocate())
         return false;
     link(linkBuffer);
-    speculative.linkOSREntries(linkBuffer);
+    m_speculative->linkOSREntries(linkBuffer);
+    addWatchpoints();
     
     // FIXME: switch the stack check & arity check over to DFGOpertaion style calls, not JIT stubs.
-    linkBuffer.link(callStackCheck, cti_stack_check);
-    linkBuffer.link(callArityCheck, m_codeBlock->m_isConstructor ? cti_op_construct_arityCheck : cti_op_call_arityCheck);
+    linkBuffer.link(m_callStackCheck, cti_stack_check);
+    linkBuffer.link(m_callArityCheck, m_codeBlock->m_isConstructor ? cti_op_construct_arityCheck : cti_op_call_arityCheck);
     
     if (m_disassembler)
         m_disassembler->dump(linkBuffer);
 
-    entryWithArityCheck = linkBuffer.locationOf(arityCheck);
+    entryWithArityCheck = linkBuffer.locationOf(m_arityCheck);
     entry = JITCode(
         linkBuffer.finalizeCodeWithoutDisassembly(),
         JITCode::DFGJIT);
@@ -239,12 +239,19 @@ struct PropertyAccessRecord {
 // relationship). The JITCompiler holds references to information required during
 // compilation, and also records information used in linking (e.g. a list of all
 // call to be linked).
+//
+// compile() and compileFunction() generate the code; link() and linkFunction()
+// link it and only then add the speculation watchpoints to their sets. Linking
+// fails if one of those sets has been fired since the code was generated.
 class JITCompiler : public CCallHelpers {
 public:
     JITCompiler(Graph& dfg);
+    ~JITCompiler();
     
-    bool compile(JITCode& entry);
-    bool compileFunction(JITCode& entry, MacroAssemblerCodePtr& entryWithArityCheck);
+    void compile();
+    void compileFunction();
+    bool link(JITCode& entry);
+    bool linkFunction(JITCode& entry, MacroAssemblerCodePtr& entryWithArityCheck);
 
     // Accessors for properties.
     Graph& graph() { return m_graph; }
@@ -378,6 +385,18 @@ public:
         m_codeBlock->appendWeakReferenceTransition(codeOrigin, from, to);
     }
     
+    // Watchpoints are added to their sets when the code is linked, after checking
+    // that none of the sets has been invalidated in the meantime.
+    void addLazily(WatchpointSet* set, Watchpoint* watchpoint)
+    {
+        m_watchpoints.append(WatchpointRecord(set, 0, watchpoint));
+    }
+    
+    void addLazily(InlineWatchpointSet& set, Watchpoint* watchpoint)
+    {
+        m_watchpoints.append(WatchpointRecord(0, &set, watchpoint));
+    }
+    
     template<typename T>
     Jump branchWeakPtr(RelationalCondition cond, T left, JSCell* weakPtr)
     {
@@ -411,6 +430,18 @@ public:
                 entry->m_expectedValues.local(local).makeTop();
             else if (m_graph[nodeIndex].variableAccessData()->shouldUseDoubleFormat())
                 entry->m_localsForcedDouble.set(local);
+            else if (m_graph.m_localsAssumedNonNegative.get(local))
+                entry->m_localsRequiredNonNegative.set(local);
+        }
+        for (size_t i = 0; i < basicBlock.osrEntryBoundsChecks.size(); ++i) {
+            const OSREntryBoundsCheck& check = basicBlock.osrEntryBoundsChecks[i];
+            NodeIndex indexNodeIndex = basicBlock.variablesAtHead.operand(check.m_indexOperand);
+            NodeIndex baseNodeIndex = basicBlock.variablesAtHead.operand(check.m_baseOperand);
+            if (indexNodeIndex == NoNode || !m_graph[indexNodeIndex].shouldGenerate())
+                continue;
+            if (baseNodeIndex == NoNode || !m_graph[baseNodeIndex].shouldGenerate())
+                continue;
+            entry->m_boundsChecks.append(check);
         }
 #else
         UNUSED_PARAM(basicBlock);
@@ -424,6 +455,8 @@ private:
     void compileEntry();
     void compileBody(SpeculativeJIT&);
     void link(LinkBuffer&);
+    bool watchpointsAreStillValid();
+    void addWatchpoints();
 
     void exitSpeculativeWithOSR(const OSRExit&, SpeculationRecovery*);
     void compileExceptionHandlers();
@@ -458,9 +491,29 @@ private:
         CodeOrigin m_codeOrigin;
     };
     
+    struct WatchpointRecord {
+        WatchpointRecord(WatchpointSet* set, InlineWatchpointSet* inlineSet, Watchpoint* watchpoint)
+            : m_set(set)
+            , m_inlineSet(inlineSet)
+            , m_watchpoint(watchpoint)
+        {
+        }
+        
+        WatchpointSet* m_set;
+        InlineWatchpointSet* m_inlineSet;
+        Watchpoint* m_watchpoint;
+    };
+    
     Vector<PropertyAccessRecord, 4> m_propertyAccesses;
     Vector<JSCallRecord, 4> m_jsCalls;
+    Vector<WatchpointRecord, 4> m_watchpoints;
     unsigned m_currentCodeOriginIndex;
+    
+    // Kept from code generation for linking.
+    OwnPtr<SpeculativeJIT> m_speculative;
+    Label m_arityCheck;
+    Call m_callStackCheck;
+    Call m_callArityCheck;
 };
 
 } } // namespace JSC::DFG
@@ -141,6 +141,13 @@ const char* nodeFlagsAsString(NodeFlags flags)
         hasPrinted = true;
     }
     
+    if (flags & NodeIndexIsInBounds) {
+        if (hasPrinted)
+            ptr.strcat("|");
+        ptr.strcat("InBounds");
+        hasPrinted = true;
+    }
+    
     if (!(flags & NodeDoesNotExit)) {
         if (hasPrinted)
             ptr.strcat("|");
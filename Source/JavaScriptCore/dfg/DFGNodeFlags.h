@@ -62,6 +62,8 @@ namespace JSC { namespace DFG {
 
 #define NodeDoesNotExit          0x4000 // This flag is negated to make it natural for the default to be that a node does exit.
 
+#define NodeIndexIsInBounds      0x8000 // Set on typed array accesses whose index has been proven to be within the array's length.
+
 typedef uint16_t NodeFlags;
 
 static inline bool nodeUsedAsNumber(NodeFlags flags)
@@ -128,6 +128,38 @@ void* prepareOSREntry(ExecState* exec, CodeBlock* codeBlock, unsigned bytecodeIn
             return 0;
         }
     }
+    
+    // Typed array accesses may have had their bounds checks removed, on the grounds that
+    // some locals never hold negative numbers and that the code reaching the accesses
+    // compares their indices to the lengths of their arrays. OSR entry gets around both,
+    // so check that the values we enter with agree.
+    
+    for (size_t local = 0; local < entry->m_expectedValues.numberOfLocals(); ++local) {
+        if (!entry->m_localsRequiredNonNegative.get(local))
+            continue;
+        JSValue value = exec->registers()[local].jsValue();
+        if (value.isNumber() && value.asNumber() < 0) {
+#if ENABLE(JIT_VERBOSE_OSR)
+            dataLogF("    OSR failed because variable %zu is %s, expected a non-negative number.\n", local, value.description());
+#endif
+            return 0;
+        }
+    }
+    
+    for (size_t i = 0; i < entry->m_boundsChecks.size(); ++i) {
+        const OSREntryBoundsCheck& check = entry->m_boundsChecks[i];
+        JSValue index = exec->registers()[check.m_indexOperand].jsValue();
+        JSValue base = exec->registers()[check.m_baseOperand].jsValue();
+        if (!index.isInt32() || !base.isCell() || base.asCell()->classInfo() != check.m_classInfo)
+            continue; // The access will speculate on these anyway.
+        uint32_t length = *reinterpret_cast<uint32_t*>(reinterpret_cast<char*>(base.asCell()) + check.m_lengthOffset);
+        if (static_cast<uint32_t>(index.asInt32()) >= length) {
+#if ENABLE(JIT_VERBOSE_OSR)
+            dataLogF("    OSR failed because index %d in variable %d is out of bounds for the array in variable %d.\n", index.asInt32(), check.m_indexOperand, check.m_baseOperand);
+#endif
+            return 0;
+        }
+    }
 
     // 2) Check the stack height. The DFG JIT may require a taller stack than the
     //    baseline JIT, in some cases. If we can't grow the stack, then don't do
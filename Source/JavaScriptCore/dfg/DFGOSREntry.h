@@ -29,20 +29,33 @@
 #include "DFGAbstractValue.h"
 #include "Operands.h"
 #include <wtf/BitVector.h>
+#include <wtf/Vector.h>
 
 namespace JSC {
 
 class ExecState;
 class CodeBlock;
+struct ClassInfo;
 
 namespace DFG {
 
 #if ENABLE(DFG_JIT)
+// A typed array access after the entry point whose bounds check was removed, because
+// the code leading to it already compared the index to the length of the array.
+struct OSREntryBoundsCheck {
+    int m_indexOperand;
+    int m_baseOperand;
+    const ClassInfo* m_classInfo;
+    size_t m_lengthOffset;
+};
+
 struct OSREntryData {
     unsigned m_bytecodeIndex;
     unsigned m_machineCodeOffset;
     Operands<AbstractValue> m_expectedValues;
     BitVector m_localsForcedDouble;
+    BitVector m_localsRequiredNonNegative;
+    Vector<OSREntryBoundsCheck> m_boundsChecks;
 };
 
 inline unsigned getOSREntryDataBytecodeIndex(OSREntryData* osrEntryData)
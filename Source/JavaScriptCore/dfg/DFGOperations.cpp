@@ -1554,7 +1554,7 @@ extern "C" void DFG_OPERATION triggerReoptimizationNow(CodeBlock* codeBlock)
     ASSERT(codeBlock->hasOptimizedReplacement());
     ASSERT(codeBlock->replacement()->getJITType() == JITCode::DFGJIT);
 
-    codeBlock->reoptimize();
+    codeBlock->reoptimize(TierUpStatistics::JettisonDueToOSRExits);
 }
 
 } // extern "C"
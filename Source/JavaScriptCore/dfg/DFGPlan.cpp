@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "DFGPlan.h"
+
+#if ENABLE(DFG_JIT)
+
+#include "CodeBlock.h"
+#include "DFGArgumentsSimplificationPhase.h"
+#include "DFGBoundsCheckEliminationPhase.h"
+#include "DFGByteCodeParser.h"
+#include "DFGCFAPhase.h"
+#include "DFGCFGSimplificationPhase.h"
+#include "DFGCSEPhase.h"
+#include "DFGConstantFoldingPhase.h"
+#include "DFGFixupPhase.h"
+#include "DFGGraph.h"
+#include "DFGJITCompiler.h"
+#include "DFGPredictionPropagationPhase.h"
+#include "DFGStructureCheckHoistingPhase.h"
+#include "DFGValidate.h"
+#include "DFGVirtualRegisterAllocationPhase.h"
+#include <wtf/CurrentTime.h>
+
+namespace JSC { namespace DFG {
+
+Plan::Plan(CompileMode compileMode, CodeBlock* codeBlock, unsigned osrEntryBytecodeIndex)
+    : m_compileMode(compileMode)
+    , m_codeBlock(codeBlock)
+    , m_osrEntryBytecodeIndex(osrEntryBytecodeIndex)
+    , m_compileTime(0)
+{
+}
+
+PassRefPtr<Plan> Plan::create(CompileMode compileMode, CodeBlock* codeBlock, unsigned osrEntryBytecodeIndex)
+{
+    return adoptRef(new Plan(compileMode, codeBlock, osrEntryBytecodeIndex));
+}
+
+Plan::~Plan()
+{
+    // The compiler refers to the graph, and both refer to the code block.
+    m_jit.clear();
+    m_graph.clear();
+}
+
+bool Plan::prepare(ExecState* exec)
+{
+    double before = WTF::monotonicallyIncreasingTime();
+    
+    // Derive our set of must-handle values. The compilation must be at least conservative
+    // enough to allow for OSR entry with these values.
+    unsigned numVarsWithValues;
+    if (m_osrEntryBytecodeIndex)
+        numVarsWithValues = m_codeBlock->m_numVars;
+    else
+        numVarsWithValues = 0;
+    Operands<JSValue> mustHandleValues(m_codeBlock->numParameters(), numVarsWithValues);
+    for (size_t i = 0; i < mustHandleValues.size(); ++i) {
+        int operand = mustHandleValues.operandForIndex(i);
+        if (operandIsArgument(operand)
+            && !operandToArgument(operand)
+            && m_compileMode == CompileFunction
+            && m_codeBlock->specializationKind() == CodeForConstruct) {
+            // Ugh. If we're in a constructor, the 'this' argument may hold garbage. It will
+            // also never be used. It doesn't matter what we put into the value for this,
+            // but it has to be an actual value that can be grokked by subsequent DFG passes,
+            // so we sanitize it here by turning it into Undefined.
+            mustHandleValues[i] = jsUndefined();
+        } else
+            mustHandleValues[i] = exec->uncheckedR(operand).jsValue();
+    }
+    
+    m_graph = adoptPtr(new Graph(exec->globalData(), m_codeBlock, m_osrEntryBytecodeIndex, mustHandleValues));
+    Graph& dfg = *m_graph;
+    if (!parse(exec, dfg)) {
+        m_compileTime += WTF::monotonicallyIncreasingTime() - before;
+        return false;
+    }
+    
+    if (m_compileMode == CompileFunction)
+        dfg.predictArgumentTypes();
+    
+    // By this point the DFG bytecode parser will have potentially mutated various tables
+    // in the CodeBlock. This is a good time to perform an early shrink, which is more
+    // powerful than a late one. It's safe to do so because we haven't generated any code
+    // that references any of the tables directly, yet.
+    m_codeBlock->shrinkToFit(CodeBlock::EarlyShrink);
+    
+    m_compileTime += WTF::monotonicallyIncreasingTime() - before;
+    return true;
+}
+
+void Plan::compile()
+{
+    SamplingRegion samplingRegion("DFG Compilation (Plan)");
+    double before = WTF::monotonicallyIncreasingTime();
+    
+    Graph& dfg = *m_graph;
+    
+    validate(dfg);
+    performPredictionPropagation(dfg);
+    performFixup(dfg);
+    performStructureCheckHoisting(dfg);
+    unsigned cnt = 1;
+    dfg.m_fixpointState = FixpointNotConverged;
+    for (;; ++cnt) {
+#if DFG_ENABLE(DEBUG_VERBOSE)
+        dataLogF("DFG beginning optimization fixpoint iteration #%u.\n", cnt);
+#endif
+        bool changed = false;
+        performCFA(dfg);
+        changed |= performConstantFolding(dfg);
+        changed |= performArgumentsSimplification(dfg);
+        changed |= performCFGSimplification(dfg);
+        changed |= performCSE(dfg);
+        if (!changed)
+            break;
+        dfg.resetExitStates();
+        performFixup(dfg);
+    }
+    dfg.m_fixpointState = FixpointConverged;
+    performCSE(dfg);
+#if DFG_ENABLE(DEBUG_VERBOSE)
+    dataLogF("DFG optimization fixpoint converged in %u iterations.\n", cnt);
+#endif
+    performBoundsCheckElimination(dfg);
+    performVirtualRegisterAllocation(dfg);
+
+    GraphDumpMode modeForFinalValidate = DumpGraph;
+#if DFG_ENABLE(DEBUG_VERBOSE)
+    dataLogF("Graph after optimization:\n");
+    dfg.dump();
+    modeForFinalValidate = DontDumpGraph;
+#endif
+    validate(dfg, modeForFinalValidate);
+    
+    m_jit = adoptPtr(new JITCompiler(dfg));
+    if (m_compileMode == CompileFunction)
+        m_jit->compileFunction();
+    else
+        m_jit->compile();
+    
+    m_compileTime += WTF::monotonicallyIncreasingTime() - before;
+}
+
+bool Plan::finalize(JITCode& jitCode, MacroAssemblerCodePtr* jitCodeWithArityCheck)
+{
+    double before = WTF::monotonicallyIncreasingTime();
+    
+    bool result;
+    if (m_compileMode == CompileFunction) {
+        ASSERT(jitCodeWithArityCheck);
+        
+        result = m_jit->linkFunction(jitCode, *jitCodeWithArityCheck);
+    } else {
+        ASSERT(m_compileMode == CompileOther);
+        ASSERT(!jitCodeWithArityCheck);
+        
+        result = m_jit->link(jitCode);
+    }
+    
+    // Nothing but the code block is needed once the code is linked.
+    m_jit.clear();
+    m_graph.clear();
+    m_compileTime += WTF::monotonicallyIncreasingTime() - before;
+    return result;
+}
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef DFGPlan_h
+#define DFGPlan_h
+
+#include <wtf/Platform.h>
+
+#if ENABLE(DFG_JIT)
+
+#include "CallFrame.h"
+#include "JITCode.h"
+#include <wtf/OwnPtr.h>
+#include <wtf/PassRefPtr.h>
+#include <wtf/RefCounted.h>
+
+namespace JSC {
+
+class CodeBlock;
+
+namespace DFG {
+
+class Graph;
+class JITCompiler;
+
+enum CompileMode { CompileFunction, CompileOther };
+
+// The state of one DFG compilation of a code block, which stays owned by the
+// caller. prepare() parses the bytecode and reads what the later phases need
+// from the heap, compile() runs the phases and generates the code, and
+// finalize() links it, failing if a watchpoint the code relies on has fired.
+class Plan : public RefCounted<Plan> {
+public:
+    static PassRefPtr<Plan> create(CompileMode, CodeBlock*, unsigned osrEntryBytecodeIndex);
+    
+    ~Plan();
+    
+    bool prepare(ExecState*);
+    void compile();
+    bool finalize(JITCode&, MacroAssemblerCodePtr* jitCodeWithArityCheck);
+    
+    CompileMode compileMode() const { return m_compileMode; }
+    CodeBlock* codeBlock() const { return m_codeBlock; }
+    
+    // The time spent in prepare(), compile() and finalize(), in seconds.
+    double compileTime() const { return m_compileTime; }
+    
+private:
+    Plan(CompileMode, CodeBlock*, unsigned osrEntryBytecodeIndex);
+    
+    CompileMode m_compileMode;
+    CodeBlock* m_codeBlock;
+    unsigned m_osrEntryBytecodeIndex;
+    double m_compileTime;
+    
+    OwnPtr<Graph> m_graph;
+    OwnPtr<JITCompiler> m_jit;
+};
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
+
+#endif // DFGPlan_h
@@ -105,9 +105,19 @@ public:
     // private 'allocateInternal' method to update internal data
     // structures accordingly.
     RegID allocate(VirtualRegister &spillMe)
+    {
+        return allocate(spillMe, 0);
+    }
+
+    // As above, but if several registers have the lowest 'spillOrder', the
+    // one holding the value that will be needed furthest in the future is
+    // spilled. 'distancesToNextUse', if not null, gives for each register
+    // (by index) how far away the next use of its value is.
+    RegID allocate(VirtualRegister &spillMe, const unsigned* distancesToNextUse)
     {
         uint32_t currentLowest = NUM_REGS;
         SpillHint currentSpillOrder = SpillHintInvalid;
+        unsigned currentDistance = 0;
 
         // This loop is broken into two halves, looping from the last allocated
         // register (the register returned last time this method was called) to
@@ -129,6 +139,14 @@ public:
             if (spillOrder < currentSpillOrder) {
                 currentSpillOrder = spillOrder;
                 currentLowest = i;
+                if (distancesToNextUse)
+                    currentDistance = distancesToNextUse[i];
+                continue;
+            }
+            // Of two equally cheap registers, prefer the one needed later.
+            if (spillOrder == currentSpillOrder && distancesToNextUse && distancesToNextUse[i] > currentDistance) {
+                currentLowest = i;
+                currentDistance = distancesToNextUse[i];
             }
         }
 
@@ -38,6 +38,7 @@ namespace JSC { namespace DFG {
 SpeculativeJIT::SpeculativeJIT(JITCompiler& jit)
     : m_compileOkay(true)
     , m_jit(jit)
+    , m_block(NoBlock)
     , m_compileIndex(0)
     , m_indexInBlock(0)
     , m_generationInfo(m_jit.codeBlock()->m_numCalleeRegisters)
@@ -1385,7 +1386,7 @@ void SpeculativeJIT::compilePeepHoleObjectEquality(Node& node, NodeIndex branchN
     GPRReg op2GPR = op2.gpr();
     
     if (m_jit.graph().globalObjectFor(node.codeOrigin)->masqueradesAsUndefinedWatchpoint()->isStillValid()) {
-        m_jit.graph().globalObjectFor(node.codeOrigin)->masqueradesAsUndefinedWatchpoint()->add(speculationWatchpoint());
+        m_jit.addLazily(m_jit.graph().globalObjectFor(node.codeOrigin)->masqueradesAsUndefinedWatchpoint(), speculationWatchpoint());
         speculationCheck(BadType, JSValueSource::unboxedCell(op1GPR), node.child1().index(), 
             m_jit.branchPtr(
                 MacroAssembler::Equal, 
@@ -1806,6 +1807,38 @@ bool SpeculativeJIT::compile()
     return true;
 }
 
+unsigned SpeculativeJIT::distanceToNextUse(NodeIndex nodeIndex)
+{
+    // Looking further ahead costs compile time in large blocks, and values
+    // that are this far from their next use are all about as good to spill.
+    static const unsigned maximumDistance = 64;
+    
+    Graph& graph = m_jit.graph();
+    if (m_block >= graph.m_blocks.size() || !graph.m_blocks[m_block])
+        return maximumDistance;
+    
+    BasicBlock& block = *graph.m_blocks[m_block];
+    unsigned end = std::min<unsigned>(block.size(), m_indexInBlock + maximumDistance);
+    for (unsigned indexInBlock = m_indexInBlock; indexInBlock < end; ++indexInBlock) {
+        Node& node = at(block[indexInBlock]);
+        // Phantoms keep their children alive but never need them in registers.
+        if (!node.shouldGenerate() || node.op() == Phantom)
+            continue;
+        if (node.flags() & NodeHasVarArgs) {
+            for (unsigned childIdx = node.firstChild(); childIdx < node.firstChild() + node.numChildren(); ++childIdx) {
+                if (graph.m_varArgChildren[childIdx].indexUnchecked() == nodeIndex)
+                    return indexInBlock - m_indexInBlock;
+            }
+            continue;
+        }
+        if (node.child1().indexUnchecked() == nodeIndex
+            || node.child2().indexUnchecked() == nodeIndex
+            || node.child3().indexUnchecked() == nodeIndex)
+            return indexInBlock - m_indexInBlock;
+    }
+    return maximumDistance;
+}
+
 void SpeculativeJIT::createOSREntries()
 {
     for (BlockIndex blockIndex = 0; blockIndex < m_jit.graph().m_blocks.size(); ++blockIndex) {
@@ -2390,10 +2423,12 @@ void SpeculativeJIT::compileGetByValOnIntTypedArray(const TypedArrayDescriptor&
 
     ASSERT(node.arrayMode().alreadyChecked(m_jit.graph(), node, m_state.forNode(node.child1())));
 
-    speculationCheck(
-        Uncountable, JSValueRegs(), NoNode,
-        m_jit.branch32(
-            MacroAssembler::AboveOrEqual, propertyReg, MacroAssembler::Address(baseReg, descriptor.m_lengthOffset)));
+    if (!(node.flags() & NodeIndexIsInBounds)) {
+        speculationCheck(
+            Uncountable, JSValueRegs(), NoNode,
+            m_jit.branch32(
+                MacroAssembler::AboveOrEqual, propertyReg, MacroAssembler::Address(baseReg, descriptor.m_lengthOffset)));
+    }
     switch (elementSize) {
     case 1:
         if (signedness == SignedTypedArray)
@@ -2506,8 +2541,9 @@ void SpeculativeJIT::compilePutByValForIntTypedArray(const TypedArrayDescriptor&
     ASSERT_UNUSED(valueGPR, valueGPR != property);
     ASSERT(valueGPR != base);
     ASSERT(valueGPR != storageReg);
+    bool needsBoundsCheck = node.op() == PutByVal && !(node.flags() & NodeIndexIsInBounds);
     MacroAssembler::Jump outOfBounds;
-    if (node.op() == PutByVal)
+    if (needsBoundsCheck)
         outOfBounds = m_jit.branch32(MacroAssembler::AboveOrEqual, property, MacroAssembler::Address(base, descriptor.m_lengthOffset));
 
     switch (elementSize) {
@@ -2523,7 +2559,7 @@ void SpeculativeJIT::compilePutByValForIntTypedArray(const TypedArrayDescriptor&
     default:
         CRASH();
     }
-    if (node.op() == PutByVal)
+    if (needsBoundsCheck)
         outOfBounds.link(&m_jit);
     noResult(m_compileIndex);
 }
@@ -2542,10 +2578,12 @@ void SpeculativeJIT::compileGetByValOnFloatTypedArray(const TypedArrayDescriptor
 
     FPRTemporary result(this);
     FPRReg resultReg = result.fpr();
-    speculationCheck(
-        Uncountable, JSValueRegs(), NoNode,
-        m_jit.branch32(
-            MacroAssembler::AboveOrEqual, propertyReg, MacroAssembler::Address(baseReg, descriptor.m_lengthOffset)));
+    if (!(node.flags() & NodeIndexIsInBounds)) {
+        speculationCheck(
+            Uncountable, JSValueRegs(), NoNode,
+            m_jit.branch32(
+                MacroAssembler::AboveOrEqual, propertyReg, MacroAssembler::Address(baseReg, descriptor.m_lengthOffset)));
+    }
     switch (elementSize) {
     case 4:
         m_jit.loadFloat(MacroAssembler::BaseIndex(storageReg, propertyReg, MacroAssembler::TimesFour), resultReg);
@@ -2579,8 +2617,9 @@ void SpeculativeJIT::compilePutByValForFloatTypedArray(const TypedArrayDescripto
     
     GPRTemporary result(this);
     
+    bool needsBoundsCheck = node.op() == PutByVal && !(node.flags() & NodeIndexIsInBounds);
     MacroAssembler::Jump outOfBounds;
-    if (node.op() == PutByVal)
+    if (needsBoundsCheck)
         outOfBounds = m_jit.branch32(MacroAssembler::AboveOrEqual, property, MacroAssembler::Address(base, descriptor.m_lengthOffset));
     
     switch (elementSize) {
@@ -2597,7 +2636,7 @@ void SpeculativeJIT::compilePutByValForFloatTypedArray(const TypedArrayDescripto
     default:
         ASSERT_NOT_REACHED();
     }
-    if (node.op() == PutByVal)
+    if (needsBoundsCheck)
         outOfBounds.link(&m_jit);
     noResult(m_compileIndex);
 }
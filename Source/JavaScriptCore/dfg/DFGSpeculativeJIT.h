@@ -183,8 +183,14 @@ public:
     // Allocate a gpr/fpr.
     GPRReg allocate()
     {
+        GPRReg gpr = m_gprs.tryAllocate();
+        if (gpr != InvalidGPRReg)
+            return gpr;
+        
+        unsigned distancesToNextUse[GPRInfo::numberOfRegisters];
+        computeDistancesToNextUse(m_gprs, distancesToNextUse);
         VirtualRegister spillMe;
-        GPRReg gpr = m_gprs.allocate(spillMe);
+        gpr = m_gprs.allocate(spillMe, distancesToNextUse);
         if (spillMe != InvalidVirtualRegister) {
 #if USE(JSVALUE32_64)
             GenerationInfo& info = m_generationInfo[spillMe];
@@ -216,12 +222,36 @@ public:
     }
     FPRReg fprAllocate()
     {
+        FPRReg fpr = m_fprs.tryAllocate();
+        if (fpr != InvalidFPRReg)
+            return fpr;
+        
+        unsigned distancesToNextUse[FPRInfo::numberOfRegisters];
+        computeDistancesToNextUse(m_fprs, distancesToNextUse);
         VirtualRegister spillMe;
-        FPRReg fpr = m_fprs.allocate(spillMe);
+        fpr = m_fprs.allocate(spillMe, distancesToNextUse);
         if (spillMe != InvalidVirtualRegister)
             spill(spillMe);
         return fpr;
     }
+    
+    // When every register is taken, we spill the value whose next use is the
+    // furthest away in the current block, among those that are equally cheap
+    // to spill. Values never cross blocks in registers, so looking ahead in
+    // the block is all the liveness information we need.
+    unsigned distanceToNextUse(NodeIndex);
+    
+    template<typename BankInfo>
+    void computeDistancesToNextUse(RegisterBank<BankInfo>& bank, unsigned* distancesToNextUse)
+    {
+        for (typename RegisterBank<BankInfo>::iterator iter = bank.begin(); iter != bank.end(); ++iter) {
+            if (iter.isLocked() || iter.name() == InvalidVirtualRegister) {
+                distancesToNextUse[iter.index()] = 0;
+                continue;
+            }
+            distancesToNextUse[iter.index()] = distanceToNextUse(m_generationInfo[iter.name()].nodeIndex());
+        }
+    }
 
     // Check whether a VirtualRegsiter is currently in a machine register.
     // We use this when filling operands to fill those that are already in
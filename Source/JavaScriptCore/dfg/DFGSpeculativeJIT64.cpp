@@ -594,7 +594,7 @@ void SpeculativeJIT::nonSpeculativeNonPeepholeCompareNull(Edge operand, bool inv
    
     JITCompiler::Jump notMasqueradesAsUndefined;
     if (m_jit.graph().globalObjectFor(m_jit.graph()[operand].codeOrigin)->masqueradesAsUndefinedWatchpoint()->isStillValid()) {
-        m_jit.graph().globalObjectFor(m_jit.graph()[operand].codeOrigin)->masqueradesAsUndefinedWatchpoint()->add(speculationWatchpoint());
+        m_jit.addLazily(m_jit.graph().globalObjectFor(m_jit.graph()[operand].codeOrigin)->masqueradesAsUndefinedWatchpoint(), speculationWatchpoint());
         m_jit.move(invert ? TrustedImm32(1) : TrustedImm32(0), resultGPR);
         notMasqueradesAsUndefined = m_jit.jump();
     } else {
@@ -657,7 +657,7 @@ void SpeculativeJIT::nonSpeculativePeepholeBranchNull(Edge operand, NodeIndex br
         notCell = m_jit.branchTest64(MacroAssembler::NonZero, argGPR, GPRInfo::tagMaskRegister);
     
     if (m_jit.graph().globalObjectFor(m_jit.graph()[operand].codeOrigin)->masqueradesAsUndefinedWatchpoint()->isStillValid()) {
-        m_jit.graph().globalObjectFor(m_jit.graph()[operand].codeOrigin)->masqueradesAsUndefinedWatchpoint()->add(speculationWatchpoint());
+        m_jit.addLazily(m_jit.graph().globalObjectFor(m_jit.graph()[operand].codeOrigin)->masqueradesAsUndefinedWatchpoint(), speculationWatchpoint());
         jump(invert ? taken : notTaken, ForceJump);
     } else {
         m_jit.loadPtr(JITCompiler::Address(argGPR, JSCell::structureOffset()), resultGPR);
@@ -1553,7 +1553,7 @@ void SpeculativeJIT::compileObjectEquality(Node& node)
     GPRReg resultGPR = result.gpr();
    
     if (m_jit.graph().globalObjectFor(node.codeOrigin)->masqueradesAsUndefinedWatchpoint()->isStillValid()) {
-        m_jit.graph().globalObjectFor(node.codeOrigin)->masqueradesAsUndefinedWatchpoint()->add(speculationWatchpoint()); 
+        m_jit.addLazily(m_jit.graph().globalObjectFor(node.codeOrigin)->masqueradesAsUndefinedWatchpoint(), speculationWatchpoint());
         speculationCheck(BadType, JSValueRegs(op1GPR), node.child1().index(), 
             m_jit.branchPtr(
                 MacroAssembler::Equal, 
@@ -1615,7 +1615,7 @@ void SpeculativeJIT::compileObjectToObjectOrOtherEquality(Edge leftChild, Edge r
     GPRReg resultGPR = result.gpr();
    
     if (m_jit.graph().globalObjectFor(leftNode.codeOrigin)->masqueradesAsUndefinedWatchpoint()->isStillValid()) { 
-        m_jit.graph().globalObjectFor(leftNode.codeOrigin)->masqueradesAsUndefinedWatchpoint()->add(speculationWatchpoint());
+        m_jit.addLazily(m_jit.graph().globalObjectFor(leftNode.codeOrigin)->masqueradesAsUndefinedWatchpoint(), speculationWatchpoint());
         speculationCheck(BadType, JSValueRegs(op1GPR), leftChild.index(), 
             m_jit.branchPtr(
                 MacroAssembler::Equal, 
@@ -1645,7 +1645,7 @@ void SpeculativeJIT::compileObjectToObjectOrOtherEquality(Edge leftChild, Edge r
     
     // We know that within this branch, rightChild must be a cell. 
     if (m_jit.graph().globalObjectFor(leftNode.codeOrigin)->masqueradesAsUndefinedWatchpoint()->isStillValid()) { 
-        m_jit.graph().globalObjectFor(leftNode.codeOrigin)->masqueradesAsUndefinedWatchpoint()->add(speculationWatchpoint());
+        m_jit.addLazily(m_jit.graph().globalObjectFor(leftNode.codeOrigin)->masqueradesAsUndefinedWatchpoint(), speculationWatchpoint());
         speculationCheck(BadType, JSValueRegs(op2GPR), rightChild.index(), 
             m_jit.branchPtr(
                 MacroAssembler::Equal, 
@@ -1714,7 +1714,7 @@ void SpeculativeJIT::compilePeepHoleObjectToObjectOrOtherEquality(Edge leftChild
     GPRReg resultGPR = result.gpr();
     
     if (m_jit.graph().globalObjectFor(branchNode.codeOrigin)->masqueradesAsUndefinedWatchpoint()->isStillValid()) {
-        m_jit.graph().globalObjectFor(branchNode.codeOrigin)->masqueradesAsUndefinedWatchpoint()->add(speculationWatchpoint());
+        m_jit.addLazily(m_jit.graph().globalObjectFor(branchNode.codeOrigin)->masqueradesAsUndefinedWatchpoint(), speculationWatchpoint());
         speculationCheck(BadType, JSValueRegs(op1GPR), leftChild.index(), 
             m_jit.branchPtr(
                 MacroAssembler::Equal, 
@@ -1744,7 +1744,7 @@ void SpeculativeJIT::compilePeepHoleObjectToObjectOrOtherEquality(Edge leftChild
     
     // We know that within this branch, rightChild must be a cell. 
     if (m_jit.graph().globalObjectFor(branchNode.codeOrigin)->masqueradesAsUndefinedWatchpoint()->isStillValid()) {
-        m_jit.graph().globalObjectFor(branchNode.codeOrigin)->masqueradesAsUndefinedWatchpoint()->add(speculationWatchpoint());
+        m_jit.addLazily(m_jit.graph().globalObjectFor(branchNode.codeOrigin)->masqueradesAsUndefinedWatchpoint(), speculationWatchpoint());
         speculationCheck(BadType, JSValueRegs(op2GPR), rightChild.index(), 
             m_jit.branchPtr(
                 MacroAssembler::Equal, 
@@ -1848,7 +1848,7 @@ void SpeculativeJIT::compileNonStringCellOrOtherLogicalNot(Edge nodeUse, bool ne
     
     MacroAssembler::Jump notCell = m_jit.branchTest64(MacroAssembler::NonZero, valueGPR, GPRInfo::tagMaskRegister);
     if (m_jit.graph().globalObjectFor(m_jit.graph()[nodeUse.index()].codeOrigin)->masqueradesAsUndefinedWatchpoint()->isStillValid()) {
-        m_jit.graph().globalObjectFor(m_jit.graph()[nodeUse.index()].codeOrigin)->masqueradesAsUndefinedWatchpoint()->add(speculationWatchpoint());
+        m_jit.addLazily(m_jit.graph().globalObjectFor(m_jit.graph()[nodeUse.index()].codeOrigin)->masqueradesAsUndefinedWatchpoint(), speculationWatchpoint());
 
         if (needSpeculationCheck) {
             speculationCheck(BadType, JSValueRegs(valueGPR), nodeUse,
@@ -1987,7 +1987,7 @@ void SpeculativeJIT::emitNonStringCellOrOtherBranch(Edge nodeUse, BlockIndex tak
     
     MacroAssembler::Jump notCell = m_jit.branchTest64(MacroAssembler::NonZero, valueGPR, GPRInfo::tagMaskRegister);
     if (m_jit.graph().globalObjectFor(m_jit.graph()[nodeUse.index()].codeOrigin)->masqueradesAsUndefinedWatchpoint()->isStillValid()) {
-        m_jit.graph().globalObjectFor(m_jit.graph()[nodeUse.index()].codeOrigin)->masqueradesAsUndefinedWatchpoint()->add(speculationWatchpoint());
+        m_jit.addLazily(m_jit.graph().globalObjectFor(m_jit.graph()[nodeUse.index()].codeOrigin)->masqueradesAsUndefinedWatchpoint(), speculationWatchpoint());
 
         if (needSpeculationCheck) {
             speculationCheck(BadType, JSValueRegs(valueGPR), nodeUse.index(), 
@@ -2639,8 +2639,8 @@ void SpeculativeJIT::compile(Node& node)
                 if (node.arrayMode().isSaneChain()) {
                     JSGlobalObject* globalObject = m_jit.globalObjectFor(node.codeOrigin);
                     ASSERT(globalObject->arrayPrototypeChainIsSane());
-                    globalObject->arrayPrototype()->structure()->addTransitionWatchpoint(speculationWatchpoint());
-                    globalObject->objectPrototype()->structure()->addTransitionWatchpoint(speculationWatchpoint());
+                    m_jit.addLazily(globalObject->arrayPrototype()->structure()->transitionWatchpointSet(), speculationWatchpoint());
+                    m_jit.addLazily(globalObject->objectPrototype()->structure()->transitionWatchpointSet(), speculationWatchpoint());
                 }
                 
                 SpeculateStrictInt32Operand property(this, node.child2());
@@ -3462,7 +3462,7 @@ void SpeculativeJIT::compile(Node& node)
     case NewArray: {
         JSGlobalObject* globalObject = m_jit.graph().globalObjectFor(node.codeOrigin);
         if (!globalObject->isHavingABadTime() && !hasArrayStorage(node.indexingType())) {
-            globalObject->havingABadTimeWatchpoint()->add(speculationWatchpoint());
+            m_jit.addLazily(globalObject->havingABadTimeWatchpoint(), speculationWatchpoint());
             
             Structure* structure = globalObject->arrayStructureForIndexingTypeDuringAllocation(node.indexingType());
             ASSERT(structure->indexingType() == node.indexingType());
@@ -3641,7 +3641,7 @@ void SpeculativeJIT::compile(Node& node)
     case NewArrayWithSize: {
         JSGlobalObject* globalObject = m_jit.graph().globalObjectFor(node.codeOrigin);
         if (!globalObject->isHavingABadTime() && !hasArrayStorage(node.indexingType())) {
-            globalObject->havingABadTimeWatchpoint()->add(speculationWatchpoint());
+            m_jit.addLazily(globalObject->havingABadTimeWatchpoint(), speculationWatchpoint());
             
             SpeculateStrictInt32Operand size(this, node.child1());
             GPRTemporary result(this);
@@ -3759,7 +3759,7 @@ void SpeculativeJIT::compile(Node& node)
         JSGlobalObject* globalObject = m_jit.graph().globalObjectFor(node.codeOrigin);
         IndexingType indexingType = node.indexingType();
         if (!globalObject->isHavingABadTime() && !hasArrayStorage(indexingType)) {
-            globalObject->havingABadTimeWatchpoint()->add(speculationWatchpoint());
+            m_jit.addLazily(globalObject->havingABadTimeWatchpoint(), speculationWatchpoint());
             
             unsigned numElements = node.numConstants();
             
@@ -3895,7 +3895,7 @@ void SpeculativeJIT::compile(Node& node)
     }
         
     case InheritorIDWatchpoint: {
-        jsCast<JSFunction*>(node.function())->addInheritorIDWatchpoint(speculationWatchpoint());
+        m_jit.addLazily(jsCast<JSFunction*>(node.function())->inheritorIDWatchpointSet(), speculationWatchpoint());
         noResult(m_compileIndex);
         break;
     }
@@ -4134,7 +4134,8 @@ void SpeculativeJIT::compile(Node& node)
         SpeculationDirection direction = node.op() == ForwardStructureTransitionWatchpoint ? ForwardSpeculation : BackwardSpeculation;
 
         m_jit.addWeakReference(node.structure());
-        node.structure()->addTransitionWatchpoint(
+        m_jit.addLazily(
+            node.structure()->transitionWatchpointSet(),
             speculationWatchpoint(
                 m_jit.graph()[node.child1()].op() == WeakJSConstant ? BadWeakConstantCache : BadCache,
                 direction));
@@ -4333,9 +4334,10 @@ void SpeculativeJIT::compile(Node& node)
     }
         
     case GlobalVarWatchpoint: {
-        m_jit.globalObjectFor(node.codeOrigin)->symbolTable()->get(
-            identifier(node.identifierNumberForCheck())->impl()).addWatchpoint(
-                speculationWatchpoint());
+        m_jit.addLazily(
+            m_jit.globalObjectFor(node.codeOrigin)->symbolTable()->get(
+                identifier(node.identifierNumberForCheck())->impl()).watchpointSet(),
+            speculationWatchpoint());
         
 #if DFG_ENABLE(JIT_ASSERT)
         GPRTemporary scratch(this);
@@ -4381,7 +4383,7 @@ void SpeculativeJIT::compile(Node& node)
         isCell.link(&m_jit);
         JITCompiler::Jump notMasqueradesAsUndefined;
         if (m_jit.graph().globalObjectFor(node.codeOrigin)->masqueradesAsUndefinedWatchpoint()->isStillValid()) {
-            m_jit.graph().globalObjectFor(node.codeOrigin)->masqueradesAsUndefinedWatchpoint()->add(speculationWatchpoint());
+            m_jit.addLazily(m_jit.graph().globalObjectFor(node.codeOrigin)->masqueradesAsUndefinedWatchpoint(), speculationWatchpoint());
             m_jit.move(TrustedImm32(0), result.gpr());
             notMasqueradesAsUndefined = m_jit.jump();
         } else {
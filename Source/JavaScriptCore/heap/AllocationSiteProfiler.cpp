@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "AllocationSiteProfiler.h"
+
+#include "CallFrame.h"
+#include "CodeBlock.h"
+#include "Executable.h"
+#include "JSGlobalData.h"
+#include "Options.h"
+#include <algorithm>
+
+namespace JSC {
+
+AllocationSiteProfiler::AllocationSiteProfiler(JSGlobalData* globalData)
+    : m_globalData(globalData)
+    , m_bytesUntilSample(0)
+    , m_bytesSinceLastSample(0)
+{
+}
+
+void AllocationSiteProfiler::didRefillFreeList(JSCell* firstCell, size_t bytes)
+{
+    m_bytesSinceLastSample += bytes;
+    if (m_bytesUntilSample > bytes) {
+        m_bytesUntilSample -= bytes;
+        return;
+    }
+    m_bytesUntilSample = Options::allocationSiteSampleInterval();
+
+    unsigned siteIndex = currentSite();
+    Site& site = m_sites[siteIndex];
+    site.samples++;
+    site.sampledBytes += m_bytesSinceLastSample;
+    m_bytesSinceLastSample = 0;
+
+    HashMap<const JSCell*, unsigned>::AddResult result = m_sampledCells.add(firstCell, siteIndex);
+    if (!result.isNewEntry) {
+        // The cell died, and its memory was handed out again.
+        m_sites[result.iterator->value].liveSamples--;
+        result.iterator->value = siteIndex;
+    }
+    site.liveSamples++;
+}
+
+unsigned AllocationSiteProfiler::currentSite()
+{
+    // Charge allocations made by native code to the JavaScript that called it.
+    CallFrame* callFrame = m_globalData->topCallFrame;
+    while (callFrame && callFrame != CallFrame::noCaller()) {
+        callFrame = callFrame->removeHostCallFrameFlag();
+        if (callFrame->codeBlock())
+            break;
+        callFrame = callFrame->callerFrame();
+    }
+
+    String url;
+    int line = 0;
+    unsigned bytecodeOffset = 0;
+    CodeBlock* codeBlock = callFrame && callFrame != CallFrame::noCaller() ? callFrame->codeBlock() : 0;
+    if (codeBlock) {
+#if ENABLE(JIT) || ENABLE(LLINT)
+#if ENABLE(DFG_JIT)
+        if (codeBlock->getJITType() == JITCode::DFGJIT)
+            bytecodeOffset = codeBlock->codeOrigin(callFrame->codeOriginIndexForDFG()).bytecodeIndex;
+        else
+#endif
+            bytecodeOffset = callFrame->bytecodeOffsetForNonDFGCode();
+#endif
+        if (bytecodeOffset >= codeBlock->instructionCount())
+            bytecodeOffset = 0;
+        url = codeBlock->ownerExecutable()->sourceURL();
+        line = codeBlock->lineNumberForBytecodeOffset(bytecodeOffset);
+    }
+
+    // Sites are source lines; allocations that no JavaScript is responsible
+    // for share the site with an empty URL.
+    String key = url + ":" + String::number(line);
+    HashMap<String, unsigned>::AddResult result = m_siteIndices.add(key, m_sites.size());
+    if (result.isNewEntry) {
+        Site site;
+        site.url = url;
+        site.line = line;
+        site.bytecodeOffset = bytecodeOffset;
+        site.samples = 0;
+        site.sampledBytes = 0;
+        site.liveSamples = 0;
+        m_sites.append(site);
+    }
+    return result.iterator->value;
+}
+
+void AllocationSiteProfiler::pruneDeadCells()
+{
+    Vector<const JSCell*> deadCells;
+    HashMap<const JSCell*, unsigned>::iterator end = m_sampledCells.end();
+    for (HashMap<const JSCell*, unsigned>::iterator it = m_sampledCells.begin(); it != end; ++it) {
+        if (Heap::isMarked(it->key))
+            continue;
+        m_sites[it->value].liveSamples--;
+        deadCells.append(it->key);
+    }
+    for (size_t i = 0; i < deadCells.size(); ++i)
+        m_sampledCells.remove(deadCells[i]);
+}
+
+unsigned AllocationSiteProfiler::siteFor(const JSCell* cell) const
+{
+    HashMap<const JSCell*, unsigned>::const_iterator it = m_sampledCells.find(cell);
+    if (it == m_sampledCells.end())
+        return unknownSite;
+    return it->value;
+}
+
+static bool moreSampledBytes(const AllocationSiteProfiler::Site* a, const AllocationSiteProfiler::Site* b)
+{
+    return a->sampledBytes > b->sampledBytes;
+}
+
+void AllocationSiteProfiler::dump(PrintStream& out) const
+{
+    Vector<const Site*> sites;
+    for (size_t i = 0; i < m_sites.size(); ++i)
+        sites.append(&m_sites[i]);
+    std::sort(sites.begin(), sites.end(), moreSampledBytes);
+
+    out.printf("Allocation sites (%lu):\n", static_cast<unsigned long>(sites.size()));
+    for (size_t i = 0; i < sites.size(); ++i) {
+        const Site& site = *sites[i];
+        out.printf("    %10lu bytes, %6lu samples, %6lu live: %s:%d (bc#%u)\n",
+            static_cast<unsigned long>(site.sampledBytes), static_cast<unsigned long>(site.samples), static_cast<unsigned long>(site.liveSamples),
+            site.url.isEmpty() ? "<native>" : site.url.utf8().data(), site.line, site.bytecodeOffset);
+    }
+}
+
+} // namespace JSC
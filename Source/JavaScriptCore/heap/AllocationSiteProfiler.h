@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef AllocationSiteProfiler_h
+#define AllocationSiteProfiler_h
+
+#include <wtf/HashMap.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/PrintStream.h>
+#include <wtf/Vector.h>
+#include <wtf/text/StringHash.h>
+#include <wtf/text/WTFString.h>
+
+namespace JSC {
+
+class JSCell;
+class JSGlobalData;
+
+// Attributes a sample of the allocations to the code that made them. A
+// sample is taken when the allocator refills its free list, so the cells a
+// JIT allocates inline are charged to the code that runs when the free list
+// runs out; with enough samples this converges on where the memory goes.
+class AllocationSiteProfiler {
+    WTF_MAKE_NONCOPYABLE(AllocationSiteProfiler);
+public:
+    static const unsigned unknownSite = 0xffffffff;
+
+    struct Site {
+        String url;
+        int line;
+        unsigned bytecodeOffset; // Of the first allocation sampled on this line.
+        size_t samples;
+        size_t sampledBytes;
+        size_t liveSamples; // Sampled cells that survived the last collection.
+    };
+
+    AllocationSiteProfiler(JSGlobalData*);
+
+    void didRefillFreeList(JSCell* firstCell, size_t bytes);
+
+    // Forgets the cells that the last collection found dead. Called after
+    // marking, before sweeping.
+    void pruneDeadCells();
+
+    const Vector<Site>& sites() const { return m_sites; }
+    unsigned siteFor(const JSCell*) const;
+
+    void dump(PrintStream&) const;
+
+private:
+    unsigned currentSite();
+
+    JSGlobalData* m_globalData;
+    size_t m_bytesUntilSample;
+    size_t m_bytesSinceLastSample;
+
+    Vector<Site> m_sites;
+    HashMap<String, unsigned> m_siteIndices;
+    HashMap<const JSCell*, unsigned> m_sampledCells;
+};
+
+} // namespace JSC
+
+#endif // AllocationSiteProfiler_h
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "BackgroundSweeper.h"
+
+#include "MarkedSpace.h"
+#include "Options.h"
+
+namespace JSC {
+
+struct GatherBlocksToSweep : MarkedBlock::VoidFunctor {
+    GatherBlocksToSweep(Vector<MarkedBlock*>& blocks, HashSet<MarkedBlock*>& pendingBlocks)
+        : m_blocks(blocks)
+        , m_pendingBlocks(pendingBlocks)
+    {
+    }
+
+    void operator()(MarkedBlock* block)
+    {
+        if (block->destructorType() != MarkedBlock::None || !block->needsSweeping())
+            return;
+        m_blocks.append(block);
+        m_pendingBlocks.add(block);
+    }
+
+    Vector<MarkedBlock*>& m_blocks;
+    HashSet<MarkedBlock*>& m_pendingBlocks;
+};
+
+BackgroundSweeper::BackgroundSweeper()
+    : m_isSweeping(false)
+    , m_sweepingThreadShouldQuit(false)
+    , m_currentBlockToSweepIndex(0)
+    , m_blockBeingSwept(0)
+    , m_sweepingThread(createThread(sweepingThreadStartFunc, this, "JavaScriptCore::Sweeper"))
+{
+    ASSERT(m_sweepingThread);
+}
+
+BackgroundSweeper::~BackgroundSweeper()
+{
+    {
+        MutexLocker locker(m_lock);
+        m_sweepingThreadShouldQuit = true;
+        m_condition.broadcast();
+    }
+    waitForThreadCompletion(m_sweepingThread);
+}
+
+void BackgroundSweeper::startSweeping(MarkedSpace& markedSpace)
+{
+    ASSERT(!m_isSweeping);
+    if (!Options::useBackgroundSweeping())
+        return;
+
+    MutexLocker locker(m_lock);
+    GatherBlocksToSweep functor(m_blocksToSweep, m_pendingBlocks);
+    markedSpace.forEachBlock(functor);
+    m_currentBlockToSweepIndex = 0;
+    m_isSweeping = !m_blocksToSweep.isEmpty();
+    if (m_isSweeping)
+        m_condition.signal();
+}
+
+void BackgroundSweeper::stopSweeping()
+{
+    if (!m_isSweeping)
+        return;
+
+    MutexLocker locker(m_lock);
+    while (m_blockBeingSwept)
+        m_condition.wait(m_lock);
+
+    // The cells on the free lists that were not taken are still dead; the
+    // next sweep of their blocks will find them again.
+    m_blocksToSweep.clear();
+    m_currentBlockToSweepIndex = 0;
+    m_pendingBlocks.clear();
+    m_freeLists.clear();
+    m_isSweeping = false;
+}
+
+bool BackgroundSweeper::takeFreeList(MarkedBlock* block, MarkedBlock::FreeList& freeList)
+{
+    if (!m_isSweeping)
+        return false;
+
+    MutexLocker locker(m_lock);
+    while (m_blockBeingSwept == block)
+        m_condition.wait(m_lock);
+
+    HashMap<MarkedBlock*, MarkedBlock::FreeList>::iterator iter = m_freeLists.find(block);
+    if (iter != m_freeLists.end()) {
+        freeList = iter->value;
+        m_freeLists.remove(iter);
+        return true;
+    }
+
+    // Keep the thread away from a block that is about to be allocated from.
+    m_pendingBlocks.remove(block);
+    return false;
+}
+
+void BackgroundSweeper::sweepingThreadStartFunc(void* sweeper)
+{
+    static_cast<BackgroundSweeper*>(sweeper)->sweepingThreadMain();
+}
+
+void BackgroundSweeper::sweepingThreadMain()
+{
+    while (true) {
+        MarkedBlock* block = 0;
+        {
+            MutexLocker locker(m_lock);
+            while (!block) {
+                if (m_sweepingThreadShouldQuit)
+                    return;
+                if (m_currentBlockToSweepIndex >= m_blocksToSweep.size()) {
+                    m_condition.wait(m_lock);
+                    continue;
+                }
+
+                // Only blocks that are still pending may be touched; the
+                // others may have been swept, or even freed, by now.
+                MarkedBlock* candidate = m_blocksToSweep[m_currentBlockToSweepIndex++];
+                HashSet<MarkedBlock*>::iterator iter = m_pendingBlocks.find(candidate);
+                if (iter == m_pendingBlocks.end())
+                    continue;
+                m_pendingBlocks.remove(iter);
+                block = candidate;
+            }
+            m_blockBeingSwept = block;
+        }
+
+        MarkedBlock::FreeList freeList = block->buildFreeList();
+
+        {
+            MutexLocker locker(m_lock);
+            m_freeLists.add(block, freeList);
+            m_blockBeingSwept = 0;
+            m_condition.broadcast();
+        }
+    }
+}
+
+} // namespace JSC
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BackgroundSweeper_h
+#define BackgroundSweeper_h
+
+#include "MarkedBlock.h"
+#include <wtf/HashMap.h>
+#include <wtf/HashSet.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+
+namespace JSC {
+
+class MarkedSpace;
+
+// Builds the free lists of blocks without destructors on a thread of its
+// own after each collection, so that allocators find them ready instead of
+// sweeping inline. The thread reads the mark bits of a block and writes the
+// free list links into its dead cells; it writes nothing else, not even the
+// state of the block. m_lock guards the queue, and a block is only swept
+// while it is pending and then marked as being swept under the lock. The
+// main thread removes a block from the pending set, waiting if the thread
+// is busy with it, before it allocates from or sweeps the block itself, and
+// stopSweeping() waits for the thread before the mark bits change or blocks
+// are freed. Dead cells are not reachable by anyone else, so the links can
+// be written while the main thread runs JavaScript.
+class BackgroundSweeper {
+    WTF_MAKE_NONCOPYABLE(BackgroundSweeper);
+public:
+    BackgroundSweeper();
+    ~BackgroundSweeper();
+
+    void startSweeping(MarkedSpace&);
+
+    // Must be called before anything but sweeping changes the mark bits or
+    // frees blocks.
+    void stopSweeping();
+
+    // Returns true, with the free list of the block, if it has been swept.
+    bool takeFreeList(MarkedBlock*, MarkedBlock::FreeList&);
+
+private:
+    void sweepingThreadMain();
+    static void sweepingThreadStartFunc(void*);
+
+    bool m_isSweeping;
+    bool m_sweepingThreadShouldQuit;
+
+    Vector<MarkedBlock*> m_blocksToSweep;
+    size_t m_currentBlockToSweepIndex;
+    HashSet<MarkedBlock*> m_pendingBlocks;
+    HashMap<MarkedBlock*, MarkedBlock::FreeList> m_freeLists;
+    MarkedBlock* m_blockBeingSwept;
+
+    Mutex m_lock;
+    ThreadCondition m_condition;
+    ThreadIdentifier m_sweepingThread;
+};
+
+} // namespace JSC
+
+#endif // BackgroundSweeper_h
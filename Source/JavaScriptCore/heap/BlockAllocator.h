@@ -160,6 +160,8 @@ public:
     template <typename T> void deallocate(T*);
     template <typename T> void deallocateCustomSize(T*);
 
+    void releaseFreeRegions();
+
 private:
     void waitForRelativeTimeWhileHoldingLock(double relative);
     void waitForRelativeTime(double relative);
@@ -181,8 +183,6 @@ private:
 
     DeadBlock* tryAllocateFromRegion(RegionSet&, DoublyLinkedList<Region>&, size_t&);
 
-    void releaseFreeRegions();
-
     template <typename T> RegionSet& regionSetFor();
 
     RegionSet m_copiedRegionSet;
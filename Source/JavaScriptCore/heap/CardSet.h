@@ -48,6 +48,7 @@ public:
     uint8_t& cardForAtom(const void*);
     bool isCardMarked(size_t);
     bool testAndClear(size_t);
+    void clearAll();
 
 private:
     uint8_t m_cards[cardCount];
@@ -78,6 +79,11 @@ template <size_t cardSize, size_t blockSize> bool CardSet<cardSize, blockSize>::
     return m_cards[i];
 }
 
+template <size_t cardSize, size_t blockSize> void CardSet<cardSize, blockSize>::clearAll()
+{
+    memset(m_cards, 0, cardCount);
+}
+
 template <size_t cardSize, size_t blockSize> bool CardSet<cardSize, blockSize>::testAndClear(size_t i)
 {
     ASSERT(i < cardCount);
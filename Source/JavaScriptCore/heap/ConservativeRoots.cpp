@@ -68,7 +68,12 @@ inline void ConservativeRoots::genericAddPointer(void* p, TinyBloomFilter filter
     markHook.mark(p);
 
     m_copiedSpace->pinIfNecessary(p);
-    
+
+    addCellIfLive(p, filter);
+}
+
+inline void ConservativeRoots::addCellIfLive(void* p, TinyBloomFilter filter)
+{
     MarkedBlock* candidate = MarkedBlock::blockFor(p);
     if (filter.ruleOut(reinterpret_cast<Bits>(candidate))) {
         ASSERT(!candidate || !m_blocks->set().contains(candidate));
@@ -103,6 +108,23 @@ void ConservativeRoots::genericAddSpan(void* begin, void* end, MarkHook& markHoo
         genericAddPointer(*it, filter, markHook);
 }
 
+template<typename MarkHook>
+void ConservativeRoots::genericAddValueSpan(Register* begin, Register* end, MarkHook& markHook)
+{
+    ASSERT(begin <= end);
+
+    TinyBloomFilter filter = m_blocks->filter();
+    for (Register* it = begin; it != end; ++it) {
+        JSValue value = it->jsValue();
+        markHook.mark(bitwise_cast<void*>(JSValue::encode(value)));
+
+        // A boxed value never points into the copied space, so nothing is pinned,
+        // and numbers are not mistaken for cells.
+        if (value.isCell())
+            addCellIfLive(value.asCell(), filter);
+    }
+}
+
 class DummyMarkHook {
 public:
     void mark(void*) { }
@@ -147,4 +169,14 @@ void ConservativeRoots::add(
     genericAddSpan(begin, end, markHook);
 }
 
+#if USE(JSVALUE64)
+void ConservativeRoots::addValues(
+    Register* begin, Register* end, JITStubRoutineSet& jitStubRoutines, DFGCodeBlocks& dfgCodeBlocks)
+{
+    CompositeMarkHook<JITStubRoutineSet, DFGCodeBlocks> markHook(
+        jitStubRoutines, dfgCodeBlocks);
+    genericAddValueSpan(begin, end, markHook);
+}
+#endif
+
 } // namespace JSC
@@ -36,6 +36,7 @@ class DFGCodeBlocks;
 class Heap;
 class JITStubRoutineSet;
 class JSCell;
+class Register;
 
 class ConservativeRoots {
 public:
@@ -45,6 +46,11 @@ public:
     void add(void* begin, void* end);
     void add(void* begin, void* end, JITStubRoutineSet&);
     void add(void* begin, void* end, JITStubRoutineSet&, DFGCodeBlocks&);
+#if USE(JSVALUE64)
+    // For spans that hold only boxed JSValues and pointers that cannot be
+    // mistaken for cells, such as the frames of baseline and LLInt code.
+    void addValues(Register* begin, Register* end, JITStubRoutineSet&, DFGCodeBlocks&);
+#endif
     
     size_t size();
     JSCell** roots();
@@ -58,6 +64,11 @@ private:
 
     template<typename MarkHook>
     void genericAddSpan(void*, void* end, MarkHook&);
+
+    template<typename MarkHook>
+    void genericAddValueSpan(Register* begin, Register* end, MarkHook&);
+
+    void addCellIfLive(void*, TinyBloomFilter);
     
     void grow();
 
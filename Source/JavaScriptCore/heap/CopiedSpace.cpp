@@ -70,6 +70,7 @@ CheckedBoolean CopiedSpace::tryAllocateSlowCase(size_t bytes, void** outPtr)
     
     ASSERT(m_heap->globalData()->apiLock().currentThreadIsHoldingLock());
     m_heap->didAllocate(m_allocator.currentCapacity());
+    m_heap->checkHeapSizeLimit(CopiedBlock::blockSize);
 
     allocateBlock();
 
@@ -80,6 +81,7 @@ CheckedBoolean CopiedSpace::tryAllocateSlowCase(size_t bytes, void** outPtr)
 CheckedBoolean CopiedSpace::tryAllocateOversize(size_t bytes, void** outPtr)
 {
     ASSERT(isOversize(bytes));
+    m_heap->checkHeapSizeLimit(bytes);
     
     CopiedBlock* block = CopiedBlock::create(m_heap->blockAllocator().allocateCustomSize(sizeof(CopiedBlock) + bytes, WTF::pageSize()));
     m_oversizeBlocks.push(block);
@@ -222,12 +224,40 @@ void CopiedSpace::startedCopying()
     if (!m_shouldDoCopyPhase)
         return;
 
+    if (Options::maxEvacuatedBytesPerCollection())
+        limitEvacuation(Options::maxEvacuatedBytesPerCollection());
+
     ASSERT(m_shouldDoCopyPhase);
     ASSERT(!m_inCopyingPhase);
     ASSERT(!m_numberOfLoanedBlocks);
     m_inCopyingPhase = true;
 }
 
+static bool hasFewerLiveBytes(CopiedBlock* a, CopiedBlock* b)
+{
+    return a->liveBytes() < b->liveBytes();
+}
+
+void CopiedSpace::limitEvacuation(size_t maxEvacuatedBytes)
+{
+    // The sparsest blocks free the most memory for the bytes copied out of
+    // them. The blocks over the budget are pinned, so that they stay where
+    // they are until the next collection.
+    Vector<CopiedBlock*> blocksToEvacuate;
+    for (CopiedBlock* block = m_fromSpace->head(); block; block = block->next()) {
+        if (block->hasWorkList())
+            blocksToEvacuate.append(block);
+    }
+    std::sort(blocksToEvacuate.begin(), blocksToEvacuate.end(), hasFewerLiveBytes);
+
+    size_t evacuatedBytes = 0;
+    for (size_t i = 0; i < blocksToEvacuate.size(); ++i) {
+        evacuatedBytes += blocksToEvacuate[i]->liveBytes();
+        if (evacuatedBytes > maxEvacuatedBytes)
+            blocksToEvacuate[i]->pin();
+    }
+}
+
 void CopiedSpace::doneCopying()
 {
     {
@@ -258,6 +288,21 @@ void CopiedSpace::doneCopying()
     m_shouldDoCopyPhase = false;
 }
 
+#if ENABLE(GGC)
+void CopiedSpace::didFinishEdenCollection()
+{
+    // An eden collection only visits the objects that are new or were
+    // written to, so the live bytes reported for a block say nothing about
+    // the storage of the old objects it holds. Keep every block until the
+    // next full collection.
+    ASSERT(!m_inCopyingPhase);
+    for (CopiedBlock* block = m_toSpace->head(); block; block = block->next())
+        block->didSurviveGC();
+    for (CopiedBlock* block = m_oversizeBlocks.head(); block; block = block->next())
+        block->didSurviveGC();
+}
+#endif
+
 size_t CopiedSpace::size()
 {
     size_t calculatedSize = 0;
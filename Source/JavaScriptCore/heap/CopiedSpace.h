@@ -62,6 +62,9 @@ public:
 
     void startedCopying();
     void doneCopying();
+#if ENABLE(GGC)
+    void didFinishEdenCollection();
+#endif
     bool isInCopyPhase() { return m_inCopyingPhase; }
 
     void pin(CopiedBlock*);
@@ -91,6 +94,8 @@ private:
     void allocateBlock();
     CopiedBlock* allocateBlockForCopyingPhase();
 
+    void limitEvacuation(size_t);
+
     void doneFillingBlock(CopiedBlock*, CopiedBlock**);
     void recycleEvacuatedBlock(CopiedBlock*);
     void recycleBorrowedBlock(CopiedBlock*);
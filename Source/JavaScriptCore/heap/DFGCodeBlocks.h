@@ -75,6 +75,9 @@ public:
     // Trace all marked code blocks (i.e. are referenced from call frames). The CodeBlock
     // is free to make use of m_dfgData->isMarked and m_dfgData->isJettisoned.
     void traceMarkedCodeBlocks(SlotVisitor&);
+    
+    // All the DFG code blocks that have not been deleted, jettisoned or not.
+    const HashSet<CodeBlock*>& codeBlocks() const { return m_set; }
 
 private:
     friend class CodeBlock;
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "GCPauseStatistics.h"
+
+#include <algorithm>
+#include <math.h>
+
+namespace JSC {
+
+static const double bucketUnit = 1e-6; // The upper bound of the first bucket, in seconds.
+
+void GCPauseHistogram::add(double seconds)
+{
+    unsigned bucket = 0;
+    for (double bound = bucketUnit; seconds >= bound && bucket < bucketCount - 1; bound *= 2)
+        ++bucket;
+    m_buckets[bucket]++;
+    m_count++;
+    m_total += seconds;
+    m_maximum = std::max(m_maximum, seconds);
+}
+
+void GCPauseHistogram::clear()
+{
+    for (unsigned i = 0; i < bucketCount; ++i)
+        m_buckets[i] = 0;
+    m_count = 0;
+    m_total = 0;
+    m_maximum = 0;
+}
+
+double GCPauseHistogram::percentile(double fraction) const
+{
+    if (!m_count)
+        return 0;
+
+    size_t rank = static_cast<size_t>(ceil(fraction * m_count));
+    size_t seen = 0;
+    for (unsigned i = 0; i < bucketCount; ++i) {
+        seen += m_buckets[i];
+        if (seen >= rank && seen)
+            return std::min(m_maximum, ldexp(bucketUnit, i));
+    }
+    return m_maximum;
+}
+
+void GCPauseStatistics::didFinishCollection()
+{
+    for (unsigned i = 0; i < NumberOfPhases; ++i) {
+        if (m_hasRunInCurrentCollection[i])
+            m_histograms[i].add(m_currentCollection[i]);
+    }
+    clearCurrentCollection();
+}
+
+void GCPauseStatistics::clear()
+{
+    for (unsigned i = 0; i < NumberOfPhases; ++i)
+        m_histograms[i].clear();
+    clearCurrentCollection();
+}
+
+void GCPauseStatistics::clearCurrentCollection()
+{
+    for (unsigned i = 0; i < NumberOfPhases; ++i) {
+        m_currentCollection[i] = 0;
+        m_hasRunInCurrentCollection[i] = false;
+    }
+}
+
+const char* GCPauseStatistics::phaseName(Phase phase)
+{
+    switch (phase) {
+    case RootMarking:
+        return "rootMarking";
+    case ConservativeScan:
+        return "conservativeScan";
+    case ParallelMarking:
+        return "parallelMarking";
+    case WeakHarvesting:
+        return "weakHarvesting";
+    case Copying:
+        return "copying";
+    case Sweeping:
+        return "sweeping";
+    case Collection:
+        return "collection";
+    case NumberOfPhases:
+        break;
+    }
+    ASSERT_NOT_REACHED();
+    return 0;
+}
+
+} // namespace JSC
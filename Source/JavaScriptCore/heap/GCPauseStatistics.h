@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef GCPauseStatistics_h
+#define GCPauseStatistics_h
+
+#include <wtf/CurrentTime.h>
+#include <wtf/Noncopyable.h>
+
+namespace JSC {
+
+// A histogram of durations, in buckets that double in size from one
+// microsecond up, so that it takes constant space however long the process
+// runs. Percentiles are reported as the upper bound of their bucket.
+class GCPauseHistogram {
+public:
+    static const unsigned bucketCount = 32;
+
+    GCPauseHistogram() { clear(); }
+
+    void add(double seconds);
+    void clear();
+
+    size_t count() const { return m_count; }
+    double total() const { return m_total; }
+    double maximum() const { return m_maximum; }
+    JS_EXPORT_PRIVATE double percentile(double fraction) const;
+
+private:
+    size_t m_buckets[bucketCount];
+    size_t m_count;
+    double m_total;
+    double m_maximum;
+};
+
+// Times the phases of the collections of a heap. Times are in seconds. A
+// phase that runs in several parts adds them up, and each histogram gets one
+// sample per collection that ran the phase.
+class GCPauseStatistics {
+    WTF_MAKE_NONCOPYABLE(GCPauseStatistics);
+public:
+    // Keep in sync with JSGarbageCollectionPhase in JSBasePrivate.h.
+    enum Phase {
+        RootMarking,
+        ConservativeScan,
+        ParallelMarking,
+        WeakHarvesting,
+        Copying,
+        Sweeping,
+        Collection, // The whole pause.
+        NumberOfPhases
+    };
+
+    class PhaseTimer {
+        WTF_MAKE_NONCOPYABLE(PhaseTimer);
+    public:
+        PhaseTimer(GCPauseStatistics& statistics, Phase phase)
+            : m_statistics(statistics)
+            , m_phase(phase)
+            , m_start(WTF::monotonicallyIncreasingTime())
+        {
+        }
+
+        ~PhaseTimer()
+        {
+            m_statistics.accumulate(m_phase, WTF::monotonicallyIncreasingTime() - m_start);
+        }
+
+    private:
+        GCPauseStatistics& m_statistics;
+        Phase m_phase;
+        double m_start;
+    };
+
+    GCPauseStatistics() { clearCurrentCollection(); }
+
+    void accumulate(Phase phase, double seconds)
+    {
+        m_currentCollection[phase] += seconds;
+        m_hasRunInCurrentCollection[phase] = true;
+    }
+    void didFinishCollection();
+    const GCPauseHistogram& histogram(Phase phase) const { return m_histograms[phase]; }
+    JS_EXPORT_PRIVATE void clear();
+
+    JS_EXPORT_PRIVATE static const char* phaseName(Phase);
+
+private:
+    void clearCurrentCollection();
+
+    GCPauseHistogram m_histograms[NumberOfPhases];
+    double m_currentCollection[NumberOfPhases];
+    bool m_hasRunInCurrentCollection[NumberOfPhases];
+};
+
+} // namespace JSC
+
+#endif // GCPauseStatistics_h
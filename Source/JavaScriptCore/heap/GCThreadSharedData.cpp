@@ -108,9 +108,7 @@ void GCThreadSharedData::reset()
 {
     ASSERT(m_sharedMarkStack.isEmpty());
     
-#if ENABLE(PARALLEL_GC)
-    m_opaqueRoots.clear();
-#else
+#if !ENABLE(PARALLEL_GC)
     ASSERT(m_opaqueRoots.isEmpty());
 #endif
     m_weakReferenceHarvesters.removeAll();
@@ -165,7 +163,12 @@ void GCThreadSharedData::didStartCopying()
 {
     {
         SpinLockHolder locker(&m_copyLock);
-        WTF::copyToVector(m_copiedSpace->m_blockSet, m_blocksToCopy);
+        // Only the blocks that are being evacuated have any copying work.
+        m_blocksToCopy.clear();
+        for (CopiedBlock* block = m_copiedSpace->m_fromSpace->head(); block; block = block->next()) {
+            if (block->hasWorkList())
+                m_blocksToCopy.append(block);
+        }
         m_copyIndex = 0;
     }
 
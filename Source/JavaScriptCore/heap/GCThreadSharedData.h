@@ -29,6 +29,7 @@
 #include "ListableHandler.h"
 #include "MarkStack.h"
 #include "MarkedBlock.h"
+#include "Options.h"
 #include "UnconditionalFinalizer.h"
 #include "WeakReferenceHarvester.h"
 #include <wtf/HashSet.h>
@@ -112,8 +113,12 @@ private:
 inline void GCThreadSharedData::getNextBlocksToCopy(size_t& start, size_t& end)
 {
     SpinLockHolder locker(&m_copyLock);
+    // Hand out smaller fragments as the work runs out, so that a thread that
+    // got blocks with long work lists does not finish long after the others.
+    size_t remaining = m_blocksToCopy.size() - m_copyIndex;
+    size_t fragmentLength = std::min<size_t>(s_blockFragmentLength, remaining / (2 * Options::numberOfGCMarkers()));
     start = m_copyIndex;
-    end = std::min(m_blocksToCopy.size(), m_copyIndex + s_blockFragmentLength);
+    end = std::min(m_blocksToCopy.size(), m_copyIndex + std::max<size_t>(1, fragmentLength));
     m_copyIndex = end;
 }
 
@@ -21,6 +21,7 @@
 #include "config.h"
 #include "Heap.h"
 
+#include "AllocationSiteProfiler.h"
 #include "CodeBlock.h"
 #include "ConservativeRoots.h"
 #include "CopiedSpace.h"
@@ -28,8 +29,10 @@
 #include "CopyVisitorInlines.h"
 #include "GCActivityCallback.h"
 #include "HeapRootVisitor.h"
+#include "HeapSnapshotBuilder.h"
 #include "HeapStatistics.h"
 #include "IncrementalSweeper.h"
+#include "ExceptionHelpers.h"
 #include "Interpreter.h"
 #include "JSGlobalData.h"
 #include "JSGlobalObject.h"
@@ -41,6 +44,7 @@
 #include <algorithm>
 #include <wtf/RAMSize.h>
 #include <wtf/CurrentTime.h>
+#include <wtf/TemporaryChange.h>
 
 using namespace std;
 using namespace JSC;
@@ -245,12 +249,23 @@ Heap::Heap(JSGlobalData* globalData, HeapType heapType)
     , m_ramSize(ramSize())
     , m_minBytesPerCycle(minHeapSize(m_heapType, m_ramSize))
     , m_sizeAfterLastCollect(0)
+    , m_sizeAfterLastAnyCollect(0)
+    , m_heapSizeLimit(0)
+    , m_heapSizeLimitTrigger(0)
+    , m_shouldCollectForHeapSizeLimit(false)
+    , m_hasPendingHeapSizeLimitError(false)
+    , m_isHandlingHeapSizeLimit(false)
     , m_bytesAllocatedLimit(m_minBytesPerCycle)
     , m_bytesAllocated(0)
     , m_bytesAbandoned(0)
+#if ENABLE(GGC)
+    , m_shouldStartIncrementalMarking(false)
+    , m_isMarkingIncrementally(false)
+#endif
     , m_operationInProgress(NoOperation)
     , m_objectSpace(this)
     , m_storageSpace(this)
+    , m_snapshotBuilder(0)
     , m_machineThreads(this)
     , m_sharedData(globalData)
     , m_slotVisitor(m_sharedData)
@@ -264,12 +279,40 @@ Heap::Heap(JSGlobalData* globalData, HeapType heapType)
     , m_sweeper(IncrementalSweeper::create(this))
 {
     m_storageSpace.init();
+    if (Options::sampleAllocationSites())
+        m_allocationSiteProfiler = adoptPtr(new AllocationSiteProfiler(globalData));
 }
 
 Heap::~Heap()
 {
 }
 
+void Heap::setHeapSizeLimit(size_t limit, PassOwnPtr<HeapSizeLimitClient> client)
+{
+    m_heapSizeLimit = limit;
+    m_heapSizeLimitClient = client;
+    m_heapSizeLimitTrigger = limit;
+    m_shouldCollectForHeapSizeLimit = false;
+    m_hasPendingHeapSizeLimitError = false;
+}
+
+// Called from the exception checks of the JIT and LLInt slow paths, where the
+// running JavaScript can take an exception.
+void Heap::throwHeapSizeLimitError()
+{
+    ASSERT(m_hasPendingHeapSizeLimitError);
+    m_hasPendingHeapSizeLimitError = false;
+    if (m_isHandlingHeapSizeLimit)
+        return;
+
+    TemporaryChange<bool> handlingHeapSizeLimit(m_isHandlingHeapSizeLimit, true);
+    JSGlobalObject* globalObject = m_globalData->dynamicGlobalObject;
+    if (m_heapSizeLimitClient)
+        m_heapSizeLimitClient->didExceedHeapSizeLimit(*m_globalData, globalObject);
+    if (globalObject && !m_globalData->exception)
+        m_globalData->exception = createOutOfMemoryError(globalObject);
+}
+
 bool Heap::isPagedOut(double deadline)
 {
     return m_objectSpace.isPagedOut(deadline) || m_storageSpace.isPagedOut(deadline);
@@ -282,6 +325,10 @@ void Heap::lastChanceToFinalize()
     ASSERT(!m_globalData->dynamicGlobalObject);
     ASSERT(m_operationInProgress == NoOperation);
 
+#if ENABLE(GGC)
+    abortIncrementalMarking();
+#endif
+    m_backgroundSweeper.stopSweeping();
     m_objectSpace.lastChanceToFinalize();
 
 #if ENABLE(SIMPLE_HEAP_PROFILING)
@@ -436,6 +483,7 @@ void Heap::markRoots(bool fullGC)
     m_jitStubRoutines.clearMarks();
     {
         GCPHASE(GatherConservativeRoots);
+        GCPauseStatistics::PhaseTimer timer(m_pauseStatistics, GCPauseStatistics::ConservativeScan);
         m_machineThreads.gatherConservativeRoots(machineThreadRoots, &dummy);
     }
 
@@ -443,6 +491,7 @@ void Heap::markRoots(bool fullGC)
     m_dfgCodeBlocks.clearMarks();
     {
         GCPHASE(GatherStackRoots);
+        GCPauseStatistics::PhaseTimer timer(m_pauseStatistics, GCPauseStatistics::ConservativeScan);
         stack().gatherConservativeRoots(
             stackRoots, m_jitStubRoutines, m_dfgCodeBlocks);
     }
@@ -455,6 +504,8 @@ void Heap::markRoots(bool fullGC)
     }
 #endif
 
+    double rootMarkingStartTime = WTF::monotonicallyIncreasingTime();
+
 #if ENABLE(GGC)
     MarkedBlock::DirtyCellVector dirtyCells;
     if (!fullGC) {
@@ -465,6 +516,7 @@ void Heap::markRoots(bool fullGC)
     {
         GCPHASE(clearMarks);
         m_objectSpace.clearMarks();
+        m_slotVisitor.clearOpaqueRoots();
     }
 
     m_sharedData.didStartMarking();
@@ -561,10 +613,13 @@ void Heap::markRoots(bool fullGC)
             m_jitStubRoutines.traceMarkedStubRoutines(visitor);
             visitor.donateAndDrain();
         }
+
+        m_pauseStatistics.accumulate(GCPauseStatistics::RootMarking, WTF::monotonicallyIncreasingTime() - rootMarkingStartTime);
     
 #if ENABLE(PARALLEL_GC)
         {
             GCPHASE(Convergence);
+            GCPauseStatistics::PhaseTimer timer(m_pauseStatistics, GCPauseStatistics::ParallelMarking);
             visitor.drainFromShared(SlotVisitor::MasterDrain);
         }
 #endif
@@ -574,6 +629,7 @@ void Heap::markRoots(bool fullGC)
     // the liveness of the rest of the object graph.
     {
         GCPHASE(VisitingLiveWeakHandles);
+        GCPauseStatistics::PhaseTimer timer(m_pauseStatistics, GCPauseStatistics::WeakHarvesting);
         MARK_LOG_ROOT(visitor, "Live Weak Handles");
         while (true) {
             m_objectSpace.visitWeakSets(heapRootVisitor);
@@ -608,6 +664,80 @@ void Heap::markRoots(bool fullGC)
     m_sharedData.reset();
 }
 
+#if ENABLE(GGC)
+void Heap::startIncrementalMarking()
+{
+    GCPHASE(StartIncrementalMarking);
+    ASSERT(!m_isMarkingIncrementally);
+
+    // Sweeping decides liveness from the mark bits, which are incomplete
+    // until the marking is done; allocators move on to new blocks instead.
+    m_sweeper->willFinishSweeping();
+    m_backgroundSweeper.stopSweeping();
+    m_objectSpace.canonicalizeCellLivenessData();
+    m_objectSpace.startIncrementalMarking();
+    m_slotVisitor.clearOpaqueRoots();
+    m_isMarkingIncrementally = true;
+
+    void* dummy;
+    ConservativeRoots machineThreadRoots(&m_objectSpace.blocks(), &m_storageSpace);
+    m_machineThreads.gatherConservativeRoots(machineThreadRoots, &dummy);
+    ConservativeRoots stackRoots(&m_objectSpace.blocks(), &m_storageSpace);
+    stack().gatherConservativeRoots(stackRoots);
+
+    // These roots only seed the marking; the final pause visits every root
+    // again, along with the cells that were written to in the meantime.
+    SlotVisitor& visitor = m_slotVisitor;
+    visitor.setup();
+    HeapRootVisitor heapRootVisitor(visitor);
+    visitor.append(machineThreadRoots);
+    visitor.append(stackRoots);
+    markProtectedObjects(heapRootVisitor);
+    m_handleSet.visitStrongHandles(heapRootVisitor);
+}
+
+void Heap::markIncrementallyIfNecessary()
+{
+    if (!m_isMarkingIncrementally && !m_shouldStartIncrementalMarking)
+        return;
+    if (!m_isSafeToCollect || m_operationInProgress != NoOperation)
+        return;
+
+    m_operationInProgress = Collection;
+    if (!m_isMarkingIncrementally) {
+        m_shouldStartIncrementalMarking = false;
+        startIncrementalMarking();
+    }
+
+    {
+        GCPHASE(MarkIncrementally);
+        ParallelModeEnabler enabler(m_slotVisitor);
+        m_slotVisitor.drainIncrementally(Options::incrementalMarkingSliceSize());
+    }
+    m_operationInProgress = NoOperation;
+}
+
+void Heap::abortIncrementalMarking()
+{
+    if (!m_isMarkingIncrementally)
+        return;
+    m_isMarkingIncrementally = false;
+
+    // The cells that were live when the marking started are still flagged
+    // as newly allocated, so the heap is left coherent; the next collection
+    // starts over with a full one.
+    m_objectSpace.canonicalizeCellLivenessData();
+    m_slotVisitor.abandonMarking();
+    m_slotVisitor.reset();
+#if ENABLE(PARALLEL_GC)
+    m_sharedData.resetChildren();
+#endif
+    m_sharedData.reset();
+    m_storageSpace.didFinishEdenCollection();
+    m_objectSpace.resetAllocators();
+}
+#endif
+
 void Heap::copyBackingStores()
 {
     m_storageSpace.startedCopying();
@@ -671,6 +801,11 @@ void Heap::deleteAllCompiledCode()
     if (m_globalData->dynamicGlobalObject)
         return;
 
+#if ENABLE(GGC)
+    // The code blocks visited so far are queued for finalization.
+    abortIncrementalMarking();
+#endif
+
     for (ExecutableBase* current = m_compiledCode.head(); current; current = current->next()) {
         if (!current->isFunctionExecutable())
             continue;
@@ -723,6 +858,7 @@ void Heap::collect(SweepToggle sweepToggle)
     m_operationInProgress = Collection;
 
     m_activityCallback->willCollect();
+    m_backgroundSweeper.stopSweeping();
 
     double lastGCStartTime = WTF::currentTime();
     if (lastGCStartTime - m_lastCodeDiscardTime > minute) {
@@ -731,11 +867,19 @@ void Heap::collect(SweepToggle sweepToggle)
     }
 
 #if ENABLE(GGC)
-    bool fullGC = sweepToggle == DoSweep;
-    if (!fullGC)
+    bool fullGC = sweepToggle == DoSweep || !Options::useGenerationalGC() || m_shouldCollectForHeapSizeLimit;
+    if (!fullGC && !m_isMarkingIncrementally)
         fullGC = (capacity() > 4 * m_sizeAfterLastCollect);  
+    if (fullGC)
+        abortIncrementalMarking();
+
+    // Completing an incremental marking is like an eden collection, except
+    // that every old object was visited since the marks were cleared.
+    bool finishesIncrementalMarking = m_isMarkingIncrementally;
+    m_isMarkingIncrementally = false;
 #else
     bool fullGC = true;
+    bool finishesIncrementalMarking = false;
 #endif
     {
         GCPHASE(Canonicalize);
@@ -746,9 +890,13 @@ void Heap::collect(SweepToggle sweepToggle)
     
     {
         GCPHASE(ReapingWeakHandles);
+        GCPauseStatistics::PhaseTimer timer(m_pauseStatistics, GCPauseStatistics::WeakHarvesting);
         m_objectSpace.reapWeakSets();
     }
 
+    if (m_allocationSiteProfiler)
+        m_allocationSiteProfiler->pruneDeadCells();
+
     JAVASCRIPTCORE_GC_MARKED();
 
     {
@@ -757,7 +905,17 @@ void Heap::collect(SweepToggle sweepToggle)
         m_objectSpace.forEachBlock(functor);
     }
 
-    copyBackingStores();
+#if ENABLE(GGC)
+    // Eden collections leave the backing stores where they are, so they do
+    // not count as running the copying phase.
+    if (!fullGC)
+        m_storageSpace.didFinishEdenCollection();
+    else
+#endif
+    {
+        GCPauseStatistics::PhaseTimer timer(m_pauseStatistics, GCPauseStatistics::Copying);
+        copyBackingStores();
+    }
 
     {
         GCPHASE(FinalizeUnconditionalFinalizers);
@@ -777,6 +935,7 @@ void Heap::collect(SweepToggle sweepToggle)
     if (sweepToggle == DoSweep) {
         SamplingRegion samplingRegion("Garbage Collection: Sweeping");
         GCPHASE(Sweeping);
+        GCPauseStatistics::PhaseTimer timer(m_pauseStatistics, GCPauseStatistics::Sweeping);
         m_objectSpace.sweep();
         m_objectSpace.shrink();
     }
@@ -790,10 +949,11 @@ void Heap::collect(SweepToggle sweepToggle)
     }
     
     size_t currentHeapSize = size();
-    if (Options::gcMaxHeapSize() && currentHeapSize > Options::gcMaxHeapSize())
+    // Only a full collection gets rid of old garbage.
+    if ((fullGC || finishesIncrementalMarking) && Options::gcMaxHeapSize() && currentHeapSize > Options::gcMaxHeapSize())
         HeapStatistics::exitWithFailure();
 
-    if (fullGC) {
+    if (fullGC || finishesIncrementalMarking) {
         m_sizeAfterLastCollect = currentHeapSize;
 
         // To avoid pathological GC churn in very small and very large heaps, we set
@@ -803,8 +963,25 @@ void Heap::collect(SweepToggle sweepToggle)
         m_bytesAllocatedLimit = maxHeapSize - currentHeapSize;
     }
     m_bytesAllocated = 0;
+    m_sizeAfterLastAnyCollect = currentHeapSize;
+    if (m_heapSizeLimit) {
+        // A collection that leaves the heap over its limit throws once, then
+        // lets the heap grow a little, so that the script can recover.
+        bool isOverLimit = currentHeapSize > m_heapSizeLimit;
+        m_hasPendingHeapSizeLimitError = isOverLimit && (m_hasPendingHeapSizeLimitError || m_shouldCollectForHeapSizeLimit);
+        m_heapSizeLimitTrigger = isOverLimit ? currentHeapSize + m_heapSizeLimit / 16 : m_heapSizeLimit;
+    }
+    m_shouldCollectForHeapSizeLimit = false;
+#if ENABLE(GGC)
+    // Start marking the old objects a while before a full collection would
+    // be needed, so that the work is spread over the allocations.
+    m_shouldStartIncrementalMarking = Options::useGenerationalGC() && Options::useIncrementalMarking()
+        && capacity() > Options::incrementalMarkingHeapGrowth() * m_sizeAfterLastCollect;
+#endif
     double lastGCEndTime = WTF::currentTime();
     m_lastGCLength = lastGCEndTime - lastGCStartTime;
+    m_pauseStatistics.accumulate(GCPauseStatistics::Collection, m_lastGCLength);
+    m_pauseStatistics.didFinishCollection();
 
     if (Options::recordGCPauseTimes())
         HeapStatistics::recordGCPauseTime(lastGCStartTime, lastGCEndTime);
@@ -821,6 +998,45 @@ void Heap::collect(SweepToggle sweepToggle)
 
     if (Options::showObjectStatistics())
         HeapStatistics::showObjectStatistics(this);
+
+    m_backgroundSweeper.startSweeping(m_objectSpace);
+}
+
+void Heap::releaseFreeBlocks()
+{
+    // The block freeing thread gives back half of the empty regions every
+    // second; under memory pressure they should all go now.
+    m_blockAllocator.releaseFreeRegions();
+}
+
+bool Heap::writeHeapSnapshot(const char* path)
+{
+    if (!m_isSafeToCollect)
+        return false;
+
+    FILE* file = fopen(path, "wb");
+    if (!file)
+        return false;
+
+    HeapSnapshotBuilder builder(file, m_allocationSiteProfiler.get());
+    m_snapshotBuilder = &builder;
+    collect(DoSweep);
+    m_snapshotBuilder = 0;
+
+    bool success = builder.finish();
+    if (fclose(file))
+        success = false;
+    return success;
+}
+
+void Heap::setAllocationSiteProfilingEnabled(bool enabled)
+{
+    if (!enabled) {
+        m_allocationSiteProfiler.clear();
+        return;
+    }
+    if (!m_allocationSiteProfiler)
+        m_allocationSiteProfiler = adoptPtr(new AllocationSiteProfiler(m_globalData));
 }
 
 void Heap::markDeadObjects()
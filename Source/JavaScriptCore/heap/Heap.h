@@ -22,9 +22,11 @@
 #ifndef Heap_h
 #define Heap_h
 
+#include "BackgroundSweeper.h"
 #include "BlockAllocator.h"
 #include "CopyVisitor.h"
 #include "DFGCodeBlocks.h"
+#include "GCPauseStatistics.h"
 #include "GCThreadSharedData.h"
 #include "HandleSet.h"
 #include "HandleStack.h"
@@ -44,6 +46,7 @@
 
 namespace JSC {
 
+    class AllocationSiteProfiler;
     class CopiedSpace;
     class CodeBlock;
     class ExecutableBase;
@@ -52,10 +55,12 @@ namespace JSC {
     class GlobalCodeBlock;
     class Heap;
     class HeapRootVisitor;
+    class HeapSnapshotBuilder;
     class IncrementalSweeper;
     class JITStubRoutine;
     class JSCell;
     class JSGlobalData;
+    class JSGlobalObject;
     class JSStack;
     class JSValue;
     class LiveObjectIterator;
@@ -72,6 +77,16 @@ namespace JSC {
 
     enum HeapType { SmallHeap, LargeHeap };
 
+    class HeapSizeLimitClient {
+    public:
+        virtual ~HeapSizeLimitClient() { }
+
+        // Called once each time a collection fails to bring the heap back under
+        // its limit. globalObject is that of the JavaScript that was allocating,
+        // or 0 if none was running. The client may terminate or reload it.
+        virtual void didExceedHeapSizeLimit(JSGlobalData&, JSGlobalObject*) = 0;
+    };
+
     class Heap {
         WTF_MAKE_NONCOPYABLE(Heap);
     public:
@@ -109,6 +124,7 @@ namespace JSC {
         JS_EXPORT_PRIVATE void setGarbageCollectionTimerEnabled(bool);
 
         JS_EXPORT_PRIVATE IncrementalSweeper* sweeper();
+        BackgroundSweeper& backgroundSweeper() { return m_backgroundSweeper; }
 
         // true if an allocation or collection is in progress
         inline bool isBusy();
@@ -133,6 +149,25 @@ namespace JSC {
         bool shouldCollect();
         void collect(SweepToggle);
 
+        // Caps the size of the heap, 0 meaning no cap. Growing past the cap makes
+        // the next marked allocation slow path run a full collection. If that
+        // leaves the heap over the cap, the next exception check of the JIT or
+        // LLInt slow paths throws an out-of-memory error and tells the client,
+        // once; the heap may then grow by a sixteenth of the cap, so that a
+        // script that catches the error can go on, before the cycle repeats.
+        JS_EXPORT_PRIVATE void setHeapSizeLimit(size_t, PassOwnPtr<HeapSizeLimitClient>);
+        size_t heapSizeLimit() const { return m_heapSizeLimit; }
+        void checkHeapSizeLimit(size_t bytes);
+        bool hasPendingHeapSizeLimitError() const { return m_hasPendingHeapSizeLimitError; }
+        JS_EXPORT_PRIVATE void throwHeapSizeLimitError();
+#if ENABLE(GGC)
+        // Runs a slice of marking from the allocation slow path, between
+        // eden collections; the next collection completes the marking.
+        void markIncrementallyIfNecessary();
+        void abortIncrementalMarking();
+        bool isMarkingIncrementally() const { return m_isMarkingIncrementally; }
+#endif
+
         void reportExtraMemoryCost(size_t cost);
         JS_EXPORT_PRIVATE void reportAbandonedObjectGraph();
 
@@ -151,6 +186,12 @@ namespace JSC {
         JS_EXPORT_PRIVATE PassOwnPtr<TypeCountSet> objectTypeCounts();
         void showStatistics();
 
+        // Runs a full collection, streaming every live cell and the references
+        // between them to the file at path; see HeapSnapshotBuilder for the format.
+        JS_EXPORT_PRIVATE bool writeHeapSnapshot(const char* path);
+        JS_EXPORT_PRIVATE void setAllocationSiteProfilingEnabled(bool);
+        AllocationSiteProfiler* allocationSiteProfiler() { return m_allocationSiteProfiler.get(); }
+
         void pushTempSortVector(Vector<ValueStringPair>*);
         void popTempSortVector(Vector<ValueStringPair>*);
     
@@ -165,9 +206,13 @@ namespace JSC {
         void getConservativeRegisterRoots(HashSet<JSCell*>& roots);
 
         double lastGCLength() { return m_lastGCLength; }
+        const GCPauseStatistics& pauseStatistics() const { return m_pauseStatistics; }
+        void clearPauseStatistics() { m_pauseStatistics.clear(); }
+        const DFGCodeBlocks& dfgCodeBlocks() const { return m_dfgCodeBlocks; }
         void increaseLastGCLength(double amount) { m_lastGCLength += amount; }
 
         JS_EXPORT_PRIVATE void deleteAllCompiledCode();
+        void releaseFreeBlocks();
 
         void didAllocate(size_t);
         void didAbandon(size_t);
@@ -210,6 +255,9 @@ namespace JSC {
         JS_EXPORT_PRIVATE void reportExtraMemoryCostSlowCase(size_t);
 
         void markRoots(bool fullGC);
+#if ENABLE(GGC)
+        void startIncrementalMarking();
+#endif
         void markProtectedObjects(HeapRootVisitor&);
         void markTempSortVectors(HeapRootVisitor&);
         void copyBackingStores();
@@ -226,15 +274,31 @@ namespace JSC {
         const size_t m_ramSize;
         const size_t m_minBytesPerCycle;
         size_t m_sizeAfterLastCollect;
+        size_t m_sizeAfterLastAnyCollect; // Unlike m_sizeAfterLastCollect, eden collections update it too.
+
+        size_t m_heapSizeLimit;
+        OwnPtr<HeapSizeLimitClient> m_heapSizeLimitClient;
+        size_t m_heapSizeLimitTrigger; // The size past which a full collection is forced.
+        bool m_shouldCollectForHeapSizeLimit;
+        bool m_hasPendingHeapSizeLimitError;
+        bool m_isHandlingHeapSizeLimit;
 
         size_t m_bytesAllocatedLimit;
         size_t m_bytesAllocated;
         size_t m_bytesAbandoned;
+
+#if ENABLE(GGC)
+        bool m_shouldStartIncrementalMarking;
+        bool m_isMarkingIncrementally;
+#endif
         
         OperationInProgress m_operationInProgress;
         BlockAllocator m_blockAllocator;
         MarkedSpace m_objectSpace;
         CopiedSpace m_storageSpace;
+        BackgroundSweeper m_backgroundSweeper;
+        OwnPtr<AllocationSiteProfiler> m_allocationSiteProfiler;
+        HeapSnapshotBuilder* m_snapshotBuilder;
 
 #if ENABLE(SIMPLE_HEAP_PROFILING)
         VTableSpectrum m_destroyedTypeCounts;
@@ -260,6 +324,7 @@ namespace JSC {
 
         JSGlobalData* m_globalData;
         double m_lastGCLength;
+        GCPauseStatistics m_pauseStatistics;
         double m_lastCodeDiscardTime;
 
         DoublyLinkedList<ExecutableBase> m_compiledCode;
@@ -284,13 +349,17 @@ namespace JSC {
 
     inline bool Heap::shouldCollect()
     {
+        if (UNLIKELY(m_shouldCollectForHeapSizeLimit) && m_isSafeToCollect && m_operationInProgress == NoOperation)
+            return true;
         if (Options::gcMaxHeapSize())
             return m_bytesAllocated > Options::gcMaxHeapSize() && m_isSafeToCollect && m_operationInProgress == NoOperation;
-#if ENABLE(GGC)
-        return m_objectSpace.nurseryWaterMark() >= m_minBytesPerCycle && m_isSafeToCollect && m_operationInProgress == NoOperation;
-#else
         return m_bytesAllocated > m_bytesAllocatedLimit && m_isSafeToCollect && m_operationInProgress == NoOperation;
-#endif
+    }
+
+    inline void Heap::checkHeapSizeLimit(size_t bytes)
+    {
+        if (UNLIKELY(!!m_heapSizeLimit) && m_sizeAfterLastAnyCollect + m_bytesAllocated + bytes > m_heapSizeLimitTrigger)
+            m_shouldCollectForHeapSizeLimit = true;
     }
 
     bool Heap::isBusy()
@@ -44,6 +44,9 @@ namespace JSC {
         void visit(JSValue*, size_t);
         void visit(JSString**);
         void visit(JSCell**);
+#if ENABLE(GGC)
+        void visitChildren(JSCell*);
+#endif
 
         SlotVisitor& visitor();
 
@@ -76,6 +79,13 @@ namespace JSC {
         m_visitor.append(slot);
     }
 
+#if ENABLE(GGC)
+    inline void HeapRootVisitor::visitChildren(JSCell* cell)
+    {
+        m_visitor.appendDirtyCell(cell);
+    }
+#endif
+
     inline SlotVisitor& HeapRootVisitor::visitor()
     {
         return m_visitor;
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "HeapSnapshotBuilder.h"
+
+#include "AllocationSiteProfiler.h"
+#include "ClassInfo.h"
+#include "JSObject.h"
+#include "MarkedBlock.h"
+#include <string.h>
+#include <wtf/text/CString.h>
+
+namespace JSC {
+
+HeapSnapshotBuilder::HeapSnapshotBuilder(FILE* file, AllocationSiteProfiler* profiler)
+    : m_file(file)
+    , m_profiler(profiler)
+    , m_nodeCount(0)
+    , m_edgeCount(0)
+    , m_failed(false)
+{
+    write("JSCHEAPS", 8);
+    writeUInt32(version);
+
+    if (!m_profiler)
+        return;
+    const Vector<AllocationSiteProfiler::Site>& sites = m_profiler->sites();
+    for (size_t i = 0; i < sites.size(); ++i) {
+        CString url = sites[i].url.utf8();
+        write("S", 1);
+        writeUInt32(i);
+        writeUInt32(static_cast<uint32_t>(sites[i].line));
+        writeUInt32(sites[i].bytecodeOffset);
+        writeString(url.data(), url.length());
+    }
+}
+
+void HeapSnapshotBuilder::appendNode(const JSCell* cell)
+{
+    uint32_t size = MarkedBlock::blockFor(cell)->cellSize();
+    uint32_t site = m_profiler ? m_profiler->siteFor(cell) : AllocationSiteProfiler::unknownSite;
+    const ClassInfo* classInfo = cell->structure()->classInfo();
+
+    MutexLocker locker(m_lock);
+    uint32_t classIndex = classFor(classInfo);
+    write("N", 1);
+    writeUInt64(reinterpret_cast<uintptr_t>(cell));
+    writeUInt32(classIndex);
+    writeUInt32(size);
+    writeUInt32(site);
+    m_nodeCount++;
+}
+
+void HeapSnapshotBuilder::appendEdge(const JSCell* from, const JSCell* to)
+{
+    MutexLocker locker(m_lock);
+    write("E", 1);
+    writeUInt64(reinterpret_cast<uintptr_t>(from));
+    writeUInt64(reinterpret_cast<uintptr_t>(to));
+    m_edgeCount++;
+}
+
+bool HeapSnapshotBuilder::finish()
+{
+    MutexLocker locker(m_lock);
+    write("Z", 1);
+    writeUInt64(m_nodeCount);
+    writeUInt64(m_edgeCount);
+    if (fflush(m_file))
+        m_failed = true;
+    return !m_failed;
+}
+
+uint32_t HeapSnapshotBuilder::classFor(const ClassInfo* classInfo)
+{
+    HashMap<const ClassInfo*, uint32_t>::AddResult result = m_classes.add(classInfo, m_classes.size());
+    if (result.isNewEntry) {
+        write("C", 1);
+        writeUInt32(result.iterator->value);
+        writeString(classInfo->className, strlen(classInfo->className));
+    }
+    return result.iterator->value;
+}
+
+void HeapSnapshotBuilder::write(const void* data, size_t size)
+{
+    if (fwrite(data, 1, size, m_file) != size)
+        m_failed = true;
+}
+
+void HeapSnapshotBuilder::writeUInt32(uint32_t value)
+{
+    write(&value, sizeof(value));
+}
+
+void HeapSnapshotBuilder::writeUInt64(uint64_t value)
+{
+    write(&value, sizeof(value));
+}
+
+void HeapSnapshotBuilder::writeString(const char* string, size_t length)
+{
+    writeUInt32(length);
+    write(string, length);
+}
+
+} // namespace JSC
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HeapSnapshotBuilder_h
+#define HeapSnapshotBuilder_h
+
+#include <stdio.h>
+#include <wtf/HashMap.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/Threading.h>
+
+namespace JSC {
+
+class AllocationSiteProfiler;
+class JSCell;
+struct ClassInfo;
+
+// Streams the object graph seen by a full collection to a file, as the
+// marking threads visit it. The format is, in the byte order of the host:
+//
+//     "JSCHEAPS" uint32 version
+//     then records, each starting with its tag byte:
+//     'S' uint32 site, int32 line, uint32 bytecode offset, uint32 length, URL in UTF-8
+//     'C' uint32 class, uint32 length, class name
+//     'N' uint64 cell, uint32 class, uint32 size, uint32 site (0xffffffff if not sampled)
+//     'E' uint64 from (0 for a root), uint64 to
+//     'Z' uint64 node count, uint64 edge count
+//
+// A class record comes before the first node that uses it, and all site
+// records come first.
+class HeapSnapshotBuilder {
+    WTF_MAKE_NONCOPYABLE(HeapSnapshotBuilder);
+public:
+    static const uint32_t version = 1;
+
+    HeapSnapshotBuilder(FILE*, AllocationSiteProfiler*);
+
+    void appendNode(const JSCell*);
+    void appendEdge(const JSCell* from, const JSCell* to);
+    bool finish();
+
+private:
+    uint32_t classFor(const ClassInfo*);
+
+    void write(const void*, size_t);
+    void writeUInt32(uint32_t);
+    void writeUInt64(uint64_t);
+    void writeString(const char*, size_t);
+
+    FILE* m_file;
+    AllocationSiteProfiler* m_profiler;
+    Mutex m_lock;
+    HashMap<const ClassInfo*, uint32_t> m_classes;
+    uint64_t m_nodeCount;
+    uint64_t m_edgeCount;
+    bool m_failed;
+};
+
+} // namespace JSC
+
+#endif // HeapSnapshotBuilder_h
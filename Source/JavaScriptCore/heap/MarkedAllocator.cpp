@@ -1,6 +1,7 @@
 #include "config.h"
 #include "MarkedAllocator.h"
 
+#include "AllocationSiteProfiler.h"
 #include "GCActivityCallback.h"
 #include "Heap.h"
 #include "IncrementalSweeper.h"
@@ -68,6 +69,12 @@ inline void* MarkedAllocator::tryAllocate(size_t bytes)
     return result;
 }
     
+inline void MarkedAllocator::didRefillFreeList(void* firstCell)
+{
+    if (AllocationSiteProfiler* profiler = m_heap->allocationSiteProfiler())
+        profiler->didRefillFreeList(static_cast<JSCell*>(firstCell), m_freeList.bytes);
+}
+
 void* MarkedAllocator::allocateSlowCase(size_t bytes)
 {
     ASSERT(m_heap->globalData()->apiLock().currentThreadIsHoldingLock());
@@ -78,18 +85,27 @@ void* MarkedAllocator::allocateSlowCase(size_t bytes)
     
     ASSERT(!m_freeList.head);
     m_heap->didAllocate(m_freeList.bytes);
+#if ENABLE(GGC)
+    m_heap->markIncrementallyIfNecessary();
+#endif
     
     void* result = tryAllocate(bytes);
     
-    if (LIKELY(result != 0))
+    if (LIKELY(result != 0)) {
+        didRefillFreeList(result);
         return result;
+    }
     
+    // Growing the heap past its size limit forces a full collection here.
+    m_heap->checkHeapSizeLimit(std::max(bytes, MarkedBlock::blockSize));
     if (m_heap->shouldCollect()) {
         m_heap->collect(Heap::DoNotSweep);
 
         result = tryAllocate(bytes);
-        if (result)
+        if (result) {
+            didRefillFreeList(result);
             return result;
+        }
     }
 
     ASSERT(!m_heap->shouldCollect());
@@ -100,6 +116,7 @@ void* MarkedAllocator::allocateSlowCase(size_t bytes)
         
     result = tryAllocate(bytes);
     ASSERT(result);
+    didRefillFreeList(result);
     return result;
 }
 
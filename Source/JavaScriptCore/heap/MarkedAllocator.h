@@ -21,6 +21,9 @@ class MarkedAllocator {
 public:
     MarkedAllocator();
     void reset();
+#if ENABLE(GGC)
+    void stopSweepingOldBlocks();
+#endif
     void canonicalizeCellLivenessData();
     size_t cellSize() { return m_cellSize; }
     MarkedBlock::DestructorType destructorType() { return m_destructorType; }
@@ -41,6 +44,7 @@ private:
     JS_EXPORT_PRIVATE void* allocateSlowCase(size_t);
     void* tryAllocate(size_t);
     void* tryAllocateHelper(size_t);
+    void didRefillFreeList(void* firstCell);
     MarkedBlock* allocateBlock(size_t);
     
     MarkedBlock::FreeList m_freeList;
@@ -96,6 +100,14 @@ inline void MarkedAllocator::reset()
     m_blocksToSweep = m_blockList.head();
 }
 
+#if ENABLE(GGC)
+inline void MarkedAllocator::stopSweepingOldBlocks()
+{
+    ASSERT(!m_currentBlock);
+    m_blocksToSweep = 0;
+}
+#endif
+
 inline void MarkedAllocator::canonicalizeCellLivenessData()
 {
     if (!m_currentBlock) {
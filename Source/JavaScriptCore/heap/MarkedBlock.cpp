@@ -112,6 +112,16 @@ MarkedBlock::FreeList MarkedBlock::sweep(SweepMode sweepMode)
     if (sweepMode == SweepOnly && m_destructorType == MarkedBlock::None)
         return FreeList();
 
+    // A block that is only swept keeps the free list the background sweeper
+    // may have built for it, since nothing else touched its dead cells.
+    FreeList sweptFreeList;
+    if (sweepMode == SweepToFreeList && heap()->backgroundSweeper().takeFreeList(this, sweptFreeList)) {
+        ASSERT(m_destructorType == MarkedBlock::None && m_state == Marked);
+        m_newlyAllocated.clear();
+        m_state = FreeListed;
+        return sweptFreeList;
+    }
+
     if (m_destructorType == MarkedBlock::ImmortalStructure)
         return sweepHelper<MarkedBlock::ImmortalStructure>(sweepMode);
     if (m_destructorType == MarkedBlock::Normal)
@@ -119,6 +129,25 @@ MarkedBlock::FreeList MarkedBlock::sweep(SweepMode sweepMode)
     return sweepHelper<MarkedBlock::None>(sweepMode);
 }
 
+MarkedBlock::FreeList MarkedBlock::buildFreeList()
+{
+    ASSERT(m_destructorType == MarkedBlock::None && m_state == Marked);
+
+    FreeCell* head = 0;
+    size_t count = 0;
+    for (size_t i = firstAtom(); i < m_endAtom; i += m_atomsPerCell) {
+        if (m_marks.get(i) || (m_newlyAllocated && m_newlyAllocated->get(i)))
+            continue;
+
+        FreeCell* freeCell = reinterpret_cast_ptr<FreeCell*>(&atoms()[i]);
+        freeCell->next = head;
+        head = freeCell;
+        ++count;
+    }
+
+    return FreeList(head, count * cellSize());
+}
+
 template<MarkedBlock::DestructorType dtorType>
 MarkedBlock::FreeList MarkedBlock::sweepHelper(SweepMode sweepMode)
 {
@@ -160,6 +189,36 @@ private:
     MarkedBlock* m_block;
 };
 
+#if ENABLE(GGC)
+void MarkedBlock::clearMarksForIncrementalMarking()
+{
+    HEAP_LOG_BLOCK_STATE_TRANSITION(this);
+
+    ASSERT(m_state != New && m_state != FreeListed);
+
+    // The mutator keeps running until the marking is done, and conservative
+    // roots are only accepted if they point to live cells. Remember which
+    // cells are live in the newly allocated bits meanwhile; the collection
+    // that completes the marking drops them.
+    if (!m_newlyAllocated)
+        m_newlyAllocated = adoptPtr(new WTF::Bitmap<atomsPerBlock>());
+
+    if (m_state == Allocated) {
+        SetNewlyAllocatedFunctor functor(this);
+        forEachCell(functor);
+    } else {
+        for (size_t i = firstAtom(); i < m_endAtom; i += m_atomsPerCell) {
+            if (m_marks.get(i))
+                m_newlyAllocated->set(i);
+        }
+    }
+
+    m_marks.clearAll();
+    m_cards.clearAll();
+    m_state = Marked;
+}
+#endif
+
 void MarkedBlock::canonicalizeCellLivenessData(const FreeList& freeList)
 {
     HEAP_LOG_BLOCK_STATE_TRANSITION(this);
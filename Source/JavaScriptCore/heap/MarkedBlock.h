@@ -53,6 +53,7 @@ namespace JSC {
     
     class Heap;
     class JSCell;
+    class LLIntOffsetsExtractor;
     class MarkedAllocator;
 
     typedef uintptr_t Bits;
@@ -70,6 +71,8 @@ namespace JSC {
     // size.
 
     class MarkedBlock : public HeapBlock<MarkedBlock> {
+        friend class LLIntOffsetsExtractor;
+
     public:
         // Ensure natural alignment for native types whilst recognizing that the smallest
         // object the heap will commonly allocate is four words.
@@ -130,6 +133,9 @@ namespace JSC {
         
         enum SweepMode { SweepOnly, SweepToFreeList };
         FreeList sweep(SweepMode = SweepOnly);
+        // Builds the free list of a Marked block without destructors, without
+        // changing the block; safe to call from the BackgroundSweeper thread.
+        FreeList buildFreeList();
 
         void shrink();
 
@@ -143,6 +149,9 @@ namespace JSC {
         void canonicalizeCellLivenessData(const FreeList&);
 
         void clearMarks();
+#if ENABLE(GGC)
+        void clearMarksForIncrementalMarking();
+#endif
         size_t markCount();
         bool isEmpty();
 
@@ -320,6 +329,10 @@ namespace JSC {
         ASSERT(m_state != New && m_state != FreeListed);
         m_marks.clearAll();
         m_newlyAllocated.clear();
+#if ENABLE(GGC)
+        // Everything is about to be visited anyway.
+        m_cards.clearAll();
+#endif
 
         // This will become true at the end of the mark phase. We set it now to
         // avoid an extra pass to do so later.
@@ -505,9 +518,19 @@ void MarkedBlock::gatherDirtyCells(DirtyCellVector& dirtyCells)
     // This is an optimisation to avoid having to walk the set of marked
     // blocks twice during GC.
     m_state = Marked;
-    
-    if (isEmpty())
+
+    // An eden collection keeps the mark bits, so that the objects that
+    // survived earlier collections are neither visited again nor swept.
+    // Objects allocated since the last collection have to earn a mark bit
+    // like in a full collection though, so forget that they are new.
+    m_newlyAllocated.clear();
+
+    if (m_marks.isEmpty()) {
+        // Only old objects are revisited; without any, cards dirtied by
+        // the unfiltered barriers of the interpreter are meaningless.
+        m_cards.clearAll();
         return;
+    }
     
     size_t cellSize = this->cellSize();
     if (cellSize == 32) {
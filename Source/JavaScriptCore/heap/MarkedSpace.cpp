@@ -224,6 +224,31 @@ void MarkedSpace::shrink()
 }
 
 #if ENABLE(GGC)
+struct ClearMarksForIncrementalMarking : MarkedBlock::VoidFunctor {
+    void operator()(MarkedBlock* block) { block->clearMarksForIncrementalMarking(); }
+};
+
+void MarkedSpace::startIncrementalMarking()
+{
+    forEachBlock<ClearMarksForIncrementalMarking>();
+
+    for (size_t cellSize = preciseStep; cellSize <= preciseCutoff; cellSize += preciseStep) {
+        allocatorFor(cellSize).stopSweepingOldBlocks();
+        normalDestructorAllocatorFor(cellSize).stopSweepingOldBlocks();
+        immortalStructureDestructorAllocatorFor(cellSize).stopSweepingOldBlocks();
+    }
+
+    for (size_t cellSize = impreciseStep; cellSize <= impreciseCutoff; cellSize += impreciseStep) {
+        allocatorFor(cellSize).stopSweepingOldBlocks();
+        normalDestructorAllocatorFor(cellSize).stopSweepingOldBlocks();
+        immortalStructureDestructorAllocatorFor(cellSize).stopSweepingOldBlocks();
+    }
+
+    m_normalSpace.largeAllocator.stopSweepingOldBlocks();
+    m_normalDestructorSpace.largeAllocator.stopSweepingOldBlocks();
+    m_immortalStructureDestructorSpace.largeAllocator.stopSweepingOldBlocks();
+}
+
 class GatherDirtyCells {
     WTF_MAKE_NONCOPYABLE(GatherDirtyCells);
 public:
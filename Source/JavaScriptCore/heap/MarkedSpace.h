@@ -104,6 +104,10 @@ public:
     void didConsumeFreeList(MarkedBlock*);
 
     void clearMarks();
+#if ENABLE(GGC)
+    void startIncrementalMarking();
+    void gatherDirtyCells(MarkedBlock::DirtyCellVector&);
+#endif
     void sweep();
     size_t objectCount();
     size_t size();
@@ -6,6 +6,7 @@
 #include "CopiedSpace.h"
 #include "CopiedSpaceInlines.h"
 #include "GCThread.h"
+#include "HeapSnapshotBuilder.h"
 #include "JSArray.h"
 #include "JSDestructibleObject.h"
 #include "JSGlobalData.h"
@@ -21,6 +22,8 @@ SlotVisitor::SlotVisitor(GCThreadSharedData& shared)
     , m_isInParallelMode(false)
     , m_shared(shared)
     , m_shouldHashConst(false)
+    , m_snapshotBuilder(0)
+    , m_snapshotOwner(0)
 #if !ASSERT_DISABLED
     , m_isCheckingForDefaultMarkViolation(false)
     , m_isDraining(false)
@@ -37,9 +40,12 @@ void SlotVisitor::setup()
 {
     m_shared.m_shouldHashConst = m_shared.m_globalData->haveEnoughNewStringsToHashConst();
     m_shouldHashConst = m_shared.m_shouldHashConst;
+    m_snapshotBuilder = m_shared.m_globalData->heap.m_snapshotBuilder;
 #if ENABLE(PARALLEL_GC)
-    for (unsigned i = 0; i < m_shared.m_gcThreads.size(); ++i)
+    for (unsigned i = 0; i < m_shared.m_gcThreads.size(); ++i) {
         m_shared.m_gcThreads[i]->slotVisitor()->m_shouldHashConst = m_shared.m_shouldHashConst;
+        m_shared.m_gcThreads[i]->slotVisitor()->m_snapshotBuilder = m_snapshotBuilder;
+    }
 #endif
 }
 
@@ -49,13 +55,25 @@ void SlotVisitor::reset()
     ASSERT(m_stack.isEmpty());
 #if ENABLE(PARALLEL_GC)
     ASSERT(m_opaqueRoots.isEmpty()); // Should have merged by now.
-#else
-    m_opaqueRoots.clear();
 #endif
     if (m_shouldHashConst) {
         m_uniqueStrings.clear();
         m_shouldHashConst = false;
     }
+    m_snapshotBuilder = 0;
+}
+
+void SlotVisitor::clearOpaqueRoots()
+{
+    // Opaque roots outlive reset(), because an eden collection does not
+    // revisit the old objects that added them.
+#if ENABLE(PARALLEL_GC)
+    ASSERT(m_opaqueRoots.isEmpty());
+    MutexLocker locker(m_shared.m_opaqueRootsLock);
+    m_shared.m_opaqueRoots.clear();
+#else
+    m_opaqueRoots.clear();
+#endif
 }
 
 void SlotVisitor::append(ConservativeRoots& conservativeRoots)
@@ -67,7 +85,7 @@ void SlotVisitor::append(ConservativeRoots& conservativeRoots)
         internalAppend(roots[i]);
 }
 
-ALWAYS_INLINE static void visitChildren(SlotVisitor& visitor, const JSCell* cell)
+ALWAYS_INLINE static void visitChildrenOf(SlotVisitor& visitor, const JSCell* cell)
 {
     StackStats::probe();
 #if ENABLE(SIMPLE_HEAP_PROFILING)
@@ -94,6 +112,28 @@ ALWAYS_INLINE static void visitChildren(SlotVisitor& visitor, const JSCell* cell
     cell->methodTable()->visitChildren(const_cast<JSCell*>(cell), visitor);
 }
 
+ALWAYS_INLINE static void visitChildren(SlotVisitor& visitor, const JSCell* cell)
+{
+    if (UNLIKELY(!!visitor.snapshotBuilder())) {
+        visitor.willVisitChildrenForSnapshot(cell);
+        visitChildrenOf(visitor, cell);
+        visitor.didVisitChildrenForSnapshot();
+        return;
+    }
+    visitChildrenOf(visitor, cell);
+}
+
+void SlotVisitor::willVisitChildrenForSnapshot(const JSCell* cell)
+{
+    m_snapshotBuilder->appendNode(cell);
+    m_snapshotOwner = cell;
+}
+
+void SlotVisitor::recordSnapshotEdge(JSCell* cell)
+{
+    m_snapshotBuilder->appendEdge(m_snapshotOwner, cell);
+}
+
 void SlotVisitor::donateKnownParallel()
 {
     StackStats::probe();
@@ -148,6 +188,39 @@ void SlotVisitor::drain()
     }
 }
 
+#if ENABLE(GGC)
+// Visits at most budget cells. The mutator runs in between, so nothing is
+// donated to other markers.
+void SlotVisitor::drainIncrementally(size_t budget)
+{
+    StackStats::probe();
+    ASSERT(m_isInParallelMode);
+
+    while (budget && !m_stack.isEmpty()) {
+        m_stack.refill();
+        for (; budget && m_stack.canRemoveLast(); --budget)
+            visitChildren(*this, m_stack.removeLast());
+    }
+
+#if ENABLE(PARALLEL_GC)
+    mergeOpaqueRootsIfNecessary();
+#endif
+}
+
+void SlotVisitor::abandonMarking()
+{
+    while (!m_stack.isEmpty()) {
+        m_stack.refill();
+        while (m_stack.canRemoveLast())
+            m_stack.removeLast();
+    }
+
+    // The cells visited so far may have registered finalizers for objects
+    // that will not survive until the next collection.
+    m_shared.m_unconditionalFinalizers.removeAll();
+}
+#endif
+
 void SlotVisitor::drainFromShared(SharedDrainMode sharedDrainMode)
 {
     StackStats::probe();
@@ -309,6 +382,8 @@ ALWAYS_INLINE void SlotVisitor::internalAppend(JSValue* slot)
                     jsCast<JSString*>(existingJSValue.asCell())->clearHashConstSingleton();
                 *slot = existingJSValue;
                 string->releaseHashConstLock();
+                if (UNLIKELY(!!m_snapshotBuilder))
+                    recordSnapshotEdge(existingJSValue.asCell());
                 return;
             }
             string->releaseHashConstLock();
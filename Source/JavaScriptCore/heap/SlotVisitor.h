@@ -36,6 +36,7 @@ namespace JSC {
 class ConservativeRoots;
 class GCThreadSharedData;
 class Heap;
+class HeapSnapshotBuilder;
 template<typename T> class Weak;
 template<typename T> class WriteBarrierBase;
 template<typename T> class JITWriteBarrier;
@@ -60,6 +61,10 @@ public:
     template<typename T>
     void appendUnbarrieredWeak(Weak<T>*);
     
+#if ENABLE(GGC)
+    void appendDirtyCell(JSCell*);
+#endif
+
     void addOpaqueRoot(void*);
     bool containsOpaqueRoot(void*);
     int opaqueRootCount();
@@ -69,11 +74,16 @@ public:
 
     void setup();
     void reset();
+    void clearOpaqueRoots();
 
     size_t visitCount() const { return m_visitCount; }
 
     void donate();
     void drain();
+#if ENABLE(GGC)
+    void drainIncrementally(size_t budget);
+    void abandonMarking();
+#endif
     void donateAndDrain();
     
     enum SharedDrainMode { SlaveDrain, MasterDrain };
@@ -83,6 +93,11 @@ public:
     void finalizeUnconditionalFinalizers();
 
     void copyLater(JSCell*, void*, size_t);
+
+    // Set while a heap snapshot is being taken; see Heap::writeHeapSnapshot().
+    HeapSnapshotBuilder* snapshotBuilder() const { return m_snapshotBuilder; }
+    void willVisitChildrenForSnapshot(const JSCell*);
+    void didVisitChildrenForSnapshot() { m_snapshotOwner = 0; }
     
 #if ENABLE(SIMPLE_HEAP_PROFILING)
     VTableSpectrum m_visitedTypeCounts;
@@ -109,6 +124,7 @@ private:
     void internalAppend(JSCell*);
     void internalAppend(JSValue);
     void internalAppend(JSValue*);
+    void recordSnapshotEdge(JSCell*);
     
     JS_EXPORT_PRIVATE void mergeOpaqueRoots();
     void mergeOpaqueRootsIfNecessary();
@@ -128,6 +144,9 @@ private:
     typedef HashMap<StringImpl*, JSValue> UniqueStringMap;
     UniqueStringMap m_uniqueStrings;
 
+    HeapSnapshotBuilder* m_snapshotBuilder;
+    const JSCell* m_snapshotOwner;
+
 #if ENABLE(OBJECT_MARK_LOGGING)
     unsigned m_logChildCount;
 #endif
@@ -93,6 +93,16 @@ inline void SlotVisitor::addUnconditionalFinalizer(UnconditionalFinalizer* uncon
     m_shared.m_unconditionalFinalizers.addThreadSafe(unconditionalFinalizer);
 }
 
+#if ENABLE(GGC)
+inline void SlotVisitor::appendDirtyCell(JSCell* cell)
+{
+    // The cell is already marked, so it would be skipped by append(); push
+    // it directly to have its children visited again.
+    ASSERT(Heap::isMarked(cell));
+    m_stack.append(cell);
+}
+#endif
+
 inline void SlotVisitor::addOpaqueRoot(void* root)
 {
 #if ENABLE(PARALLEL_GC)
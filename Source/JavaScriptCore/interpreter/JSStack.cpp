@@ -32,6 +32,7 @@
 
 #include "ConservativeRoots.h"
 #include "Interpreter.h"
+#include "Options.h"
 
 namespace JSC {
 
@@ -98,9 +99,42 @@ void JSStack::gatherConservativeRoots(ConservativeRoots& conservativeRoots)
 
 void JSStack::gatherConservativeRoots(ConservativeRoots& conservativeRoots, JITStubRoutineSet& jitStubRoutines, DFGCodeBlocks& dfgCodeBlocks)
 {
+#if USE(JSVALUE64)
+    if (Options::usePreciseJSStackScanning() && gatherPreciseRoots(conservativeRoots, jitStubRoutines, dfgCodeBlocks))
+        return;
+#endif
     conservativeRoots.add(begin(), getTopOfStack(), jitStubRoutines, dfgCodeBlocks);
 }
 
+#if USE(JSVALUE64)
+// The LLInt and the baseline JIT keep only boxed JSValues in their frames, so
+// a frame slot can name a cell only if it is tagged as one. Scanning them that
+// way keeps numbers and frame header fields from retaining cells, and does not
+// pin copied blocks. DFG frames also hold unboxed values and spilled butterfly
+// pointers, whose locations are only recovered at OSR exit, so they stay
+// conservative.
+bool JSStack::gatherPreciseRoots(ConservativeRoots& roots, JITStubRoutineSet& jitStubRoutines, DFGCodeBlocks& dfgCodeBlocks)
+{
+    Register* top = getTopOfStack();
+    Vector<CallFrame*, 16> dfgFrames;
+    for (CallFrame* frame = m_topCallFrame; frame; frame = frame->callerFrameNoFlags()) {
+        // Frames that are not on this stack mean we cannot trust the walk.
+        if (frame->registers() < begin() || frame->registers() > top)
+            return false;
+#if ENABLE(DFG_JIT)
+        JSC::CodeBlock* codeBlock = frame->codeBlock();
+        if (codeBlock && codeBlock->getJITType() == JITCode::DFGJIT)
+            dfgFrames.append(frame);
+#endif
+    }
+
+    roots.addValues(begin(), top, jitStubRoutines, dfgCodeBlocks);
+    for (size_t i = 0; i < dfgFrames.size(); ++i)
+        roots.add(dfgFrames[i]->registers(), dfgFrames[i]->frameExtent(), jitStubRoutines, dfgCodeBlocks);
+    return true;
+}
+#endif
+
 void JSStack::releaseExcessCapacity()
 {
     ptrdiff_t delta = reinterpret_cast<uintptr_t>(m_commitEnd) - reinterpret_cast<uintptr_t>(m_reservation.base());
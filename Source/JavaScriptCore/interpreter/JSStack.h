@@ -109,6 +109,10 @@ namespace JSC {
 #endif // !ENABLE(DEBUG_JSSTACK)
 
     private:
+#if USE(JSVALUE64)
+        bool gatherPreciseRoots(ConservativeRoots&, JITStubRoutineSet&, DFGCodeBlocks&);
+#endif
+
         Register* reservationEnd() const
         {
             char* base = static_cast<char*>(m_reservation.base());
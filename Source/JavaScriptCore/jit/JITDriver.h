@@ -34,6 +34,7 @@
 #include "DFGDriver.h"
 #include "JIT.h"
 #include "LLIntEntrypoints.h"
+#include <wtf/CurrentTime.h>
 
 namespace JSC {
 
@@ -51,6 +52,7 @@ inline bool jitCompileIfAppropriate(ExecState* exec, OwnPtr<CodeBlockType>& code
     codeBlock->unlinkIncomingCalls();
     
     JITCode oldJITCode = jitCode;
+    double before = WTF::monotonicallyIncreasingTime();
     
     bool dfgCompiled = false;
     if (jitType == JITCode::DFGJIT)
@@ -60,6 +62,7 @@ inline bool jitCompileIfAppropriate(ExecState* exec, OwnPtr<CodeBlockType>& code
             codeBlock->alternative()->unlinkIncomingCalls();
     } else {
         if (codeBlock->alternative()) {
+            globalData.tierUpStatistics.didFailToOptimize(codeBlock->alternative(), WTF::monotonicallyIncreasingTime() - before);
             codeBlock = static_pointer_cast<CodeBlockType>(codeBlock->releaseAlternative());
             jitCode = oldJITCode;
             return false;
@@ -71,6 +74,7 @@ inline bool jitCompileIfAppropriate(ExecState* exec, OwnPtr<CodeBlockType>& code
         }
     }
     codeBlock->setJITCode(jitCode, MacroAssemblerCodePtr());
+    globalData.tierUpStatistics.didCompile(codeBlock.get(), WTF::monotonicallyIncreasingTime() - before);
     
     return true;
 }
@@ -89,6 +93,7 @@ inline bool jitCompileFunctionIfAppropriate(ExecState* exec, OwnPtr<FunctionCode
     
     JITCode oldJITCode = jitCode;
     MacroAssemblerCodePtr oldJITCodeWithArityCheck = jitCodeWithArityCheck;
+    double before = WTF::monotonicallyIncreasingTime();
     
     bool dfgCompiled = false;
     if (jitType == JITCode::DFGJIT)
@@ -98,6 +103,7 @@ inline bool jitCompileFunctionIfAppropriate(ExecState* exec, OwnPtr<FunctionCode
             codeBlock->alternative()->unlinkIncomingCalls();
     } else {
         if (codeBlock->alternative()) {
+            globalData.tierUpStatistics.didFailToOptimize(codeBlock->alternative(), WTF::monotonicallyIncreasingTime() - before);
             codeBlock = static_pointer_cast<FunctionCodeBlock>(codeBlock->releaseAlternative());
             jitCode = oldJITCode;
             jitCodeWithArityCheck = oldJITCodeWithArityCheck;
@@ -111,6 +117,7 @@ inline bool jitCompileFunctionIfAppropriate(ExecState* exec, OwnPtr<FunctionCode
         }
     }
     codeBlock->setJITCode(jitCode, jitCodeWithArityCheck);
+    globalData.tierUpStatistics.didCompile(codeBlock.get(), WTF::monotonicallyIncreasingTime() - before);
     
     return true;
 }
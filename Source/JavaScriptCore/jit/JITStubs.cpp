@@ -1035,18 +1035,26 @@ static NEVER_INLINE void returnToThrowTrampoline(JSGlobalData* globalData, Retur
         returnToThrowTrampoline(stackFrame.globalData, STUB_RETURN_ADDRESS, STUB_RETURN_ADDRESS);\
     } while (0)
 
+#define CHECK_FOR_HEAP_SIZE_LIMIT() \
+    do { \
+        if (UNLIKELY(stackFrame.globalData->heap.hasPendingHeapSizeLimitError())) \
+            stackFrame.globalData->heap.throwHeapSizeLimitError(); \
+    } while (0)
 #define CHECK_FOR_EXCEPTION() \
     do { \
+        CHECK_FOR_HEAP_SIZE_LIMIT(); \
         if (UNLIKELY(stackFrame.globalData->exception)) \
             VM_THROW_EXCEPTION(); \
     } while (0)
 #define CHECK_FOR_EXCEPTION_AT_END() \
     do { \
+        CHECK_FOR_HEAP_SIZE_LIMIT(); \
         if (UNLIKELY(stackFrame.globalData->exception)) \
             VM_THROW_EXCEPTION_AT_END(); \
     } while (0)
 #define CHECK_FOR_EXCEPTION_VOID() \
     do { \
+        CHECK_FOR_HEAP_SIZE_LIMIT(); \
         if (UNLIKELY(stackFrame.globalData->exception)) { \
             VM_THROW_EXCEPTION_AT_END(); \
             return; \
@@ -1353,7 +1361,10 @@ DEFINE_STUB_FUNCTION(int, timeout_check)
     JSGlobalData* globalData = stackFrame.globalData;
     TimeoutChecker& timeoutChecker = globalData->timeoutChecker;
 
-    if (globalData->terminator.shouldTerminate()) {
+    CHECK_FOR_HEAP_SIZE_LIMIT();
+    if (globalData->exception)
+        VM_THROW_EXCEPTION_AT_END();
+    else if (globalData->terminator.shouldTerminate()) {
         globalData->exception = createTerminatedExecutionException(globalData);
         VM_THROW_EXCEPTION_AT_END();
     } else if (timeoutChecker.didTimeOut(stackFrame.callFrame)) {
@@ -1846,7 +1857,7 @@ DEFINE_STUB_FUNCTION(void, optimize)
 #if ENABLE(JIT_VERBOSE_OSR)
             dataLogF("Triggering reoptimization of ", *codeBlock, "(", *codeBlock->replacement(), ") (in loop).\n");
 #endif
-            codeBlock->reoptimize();
+            codeBlock->reoptimize(TierUpStatistics::JettisonDueToLoopOSRExits);
             return;
         }
     } else {
@@ -1919,7 +1930,7 @@ DEFINE_STUB_FUNCTION(void, optimize)
 #if ENABLE(JIT_VERBOSE_OSR)
         dataLogF("Triggering reoptimization of ", *codeBlock, " -> ", *codeBlock->replacement(), " (after OSR fail).\n");
 #endif
-        codeBlock->reoptimize();
+        codeBlock->reoptimize(TierUpStatistics::JettisonDueToOSREntryFailures);
         return;
     }
 
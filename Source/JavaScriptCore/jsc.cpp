@@ -102,6 +102,7 @@ static EncodedJSValue JSC_HOST_CALL functionLoad(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionCheckSyntax(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionReadline(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionPreciseTime(ExecState*);
+static EncodedJSValue JSC_HOST_CALL functionTierUpStatistics(ExecState*);
 static NO_RETURN_WITH_VALUE EncodedJSValue JSC_HOST_CALL functionQuit(ExecState*);
 
 #if ENABLE(SAMPLING_FLAGS)
@@ -133,6 +134,7 @@ public:
     bool m_interactive;
     bool m_dump;
     bool m_exitCode;
+    String m_tierUpStatisticsPath;
     Vector<Script> m_scripts;
     Vector<String> m_arguments;
 
@@ -216,6 +218,7 @@ protected:
         addFunction(globalData, "jscStack", functionJSCStack, 1);
         addFunction(globalData, "readline", functionReadline, 0);
         addFunction(globalData, "preciseTime", functionPreciseTime, 0);
+        addFunction(globalData, "tierUpStatistics", functionTierUpStatistics, 0);
 #if ENABLE(SAMPLING_FLAGS)
         addFunction(globalData, "setSamplingFlags", functionSetSamplingFlags, 1);
         addFunction(globalData, "clearSamplingFlags", functionClearSamplingFlags, 1);
@@ -457,6 +460,11 @@ EncodedJSValue JSC_HOST_CALL functionPreciseTime(ExecState*)
     return JSValue::encode(jsNumber(currentTime()));
 }
 
+EncodedJSValue JSC_HOST_CALL functionTierUpStatistics(ExecState* exec)
+{
+    return JSValue::encode(jsString(exec, exec->globalData().tierUpStatistics.toJSON(exec->globalData())));
+}
+
 EncodedJSValue JSC_HOST_CALL functionQuit(ExecState*)
 {
     exit(EXIT_SUCCESS);
@@ -646,6 +654,7 @@ static NO_RETURN void printUsageStatement(bool help = false)
     fprintf(stderr, "  -f         Specifies a source file (deprecated)\n");
     fprintf(stderr, "  -h|--help  Prints this help message\n");
     fprintf(stderr, "  -i         Enables interactive mode (default if no files are specified)\n");
+    fprintf(stderr, "  -p <file>  Writes the tier-up statistics to the file as JSON before exiting\n");
 #if HAVE(SIGNAL_H)
     fprintf(stderr, "  -s         Installs signal handlers that exit on a crash (Unix platforms only)\n");
 #endif
@@ -687,6 +696,13 @@ void CommandLine::parseArguments(int argc, char** argv)
             m_dump = true;
             continue;
         }
+        if (!strcmp(arg, "-p")) {
+            if (++i == argc)
+                printUsageStatement();
+            m_tierUpStatisticsPath = argv[i];
+            JSC::Options::recordTierUpStatistics() = true;
+            continue;
+        }
         if (!strcmp(arg, "-s")) {
 #if HAVE(SIGNAL_H)
             signal(SIGILL, _exit);
@@ -757,6 +773,16 @@ int jscmain(int argc, char** argv)
 
     result = success ? 0 : 3;
 
+    if (!options.m_tierUpStatisticsPath.isNull()) {
+        FILE* file = fopen(options.m_tierUpStatisticsPath.utf8().data(), "w");
+        if (file) {
+            CString json = globalData->tierUpStatistics.toJSON(*globalData).utf8();
+            fwrite(json.data(), 1, json.length(), file);
+            fclose(file);
+        } else
+            fprintf(stderr, "Could not open file: %s\n", options.m_tierUpStatisticsPath.utf8().data());
+    }
+
     if (options.m_exitCode)
         printf("jsc exiting %d\n", result);
 
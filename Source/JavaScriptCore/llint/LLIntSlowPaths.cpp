@@ -86,6 +86,8 @@ namespace JSC { namespace LLInt {
     } while (false)
 
 #define LLINT_CHECK_EXCEPTION() do {                    \
+        if (UNLIKELY(globalData.heap.hasPendingHeapSizeLimitError())) \
+            globalData.heap.throwHeapSizeLimitError();  \
         if (UNLIKELY(globalData.exception)) {           \
             pc = returnToThrow(exec, pc);               \
             LLINT_END_IMPL();                           \
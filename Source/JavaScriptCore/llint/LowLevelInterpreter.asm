@@ -161,6 +161,11 @@ else
     const VectorBufferOffset = 4
 end
 
+# Copied from MarkedBlock.h
+const MarkedBlockMask = ~0xffff
+const MarkedBlockCardShift = 8
+const MarkedBlockCardMask = 0xff
+
 
 # Some common utilities.
 macro crash()
@@ -213,6 +218,29 @@ macro traceExecution()
     end
 end
 
+# Dirties the card of a cell that was just stored into, so that the next eden
+# collection visits the cell again if it is old. This does the same as
+# JIT::emitWriteBarrier(), without filtering on the mark bits. Clobbers both
+# registers.
+macro writeBarrierOnCell(cell, scratch)
+    if GGC
+        move cell, scratch
+        urshiftp MarkedBlockCardShift, scratch
+        andp MarkedBlockCardMask, scratch
+        andp MarkedBlockMask, cell
+        addp scratch, cell
+        storeb 1, MarkedBlock::m_cards[cell]
+    end
+end
+
+macro writeBarrierOnGlobalObject(scratch1, scratch2)
+    if GGC
+        loadp CodeBlock[cfr], scratch1
+        loadp CodeBlock::m_globalObject[scratch1], scratch1
+        writeBarrierOnCell(scratch1, scratch2)
+    end
+end
+
 macro callTargetFunction(callLinkInfo)
     if C_LOOP
         cloopCallJSFunction LLIntCallLinkInfo::machineCodeTarget[callLinkInfo]
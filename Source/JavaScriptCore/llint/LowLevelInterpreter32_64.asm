@@ -271,8 +271,14 @@ macro loadConstantOrVariablePayloadUnchecked(index, payload)
         payload)
 end
 
-macro writeBarrier(tag, payload)
-    # Nothing to do, since we don't have a generational or incremental collector.
+# Dirties the card of the cell in the given operand of the current instruction.
+# Clobbers t1 and t2.
+macro writeBarrierOnOperand(cellOperand)
+    if GGC
+        loadi cellOperand * 4[PC], t1
+        loadConstantOrVariablePayloadUnchecked(t1, t2)
+        writeBarrierOnCell(t2, t1)
+    end
 end
 
 macro valueProfile(tag, payload, profile)
@@ -993,9 +999,9 @@ _llint_op_init_global_const:
     loadi 8[PC], t1
     loadi 4[PC], t0
     loadConstantOrVariable(t1, t2, t3)
-    writeBarrier(t2, t3)
     storei t2, TagOffset[t0]
     storei t3, PayloadOffset[t0]
+    writeBarrierOnGlobalObject(t1, t2)
     dispatch(5)
 
 
@@ -1006,9 +1012,9 @@ _llint_op_init_global_const_check:
     loadi 4[PC], t0
     btbnz [t2], .opInitGlobalConstCheckSlow
     loadConstantOrVariable(t1, t2, t3)
-    writeBarrier(t2, t3)
     storei t2, TagOffset[t0]
     storei t3, PayloadOffset[t0]
+    writeBarrierOnGlobalObject(t1, t2)
     dispatch(5)
 .opInitGlobalConstCheckSlow:
     callSlowPath(_llint_slow_path_init_global_const_check)
@@ -1107,9 +1113,9 @@ macro putById(getPropertyStorage)
             bpneq JSCell::m_structure[t0], t1, .opPutByIdSlow
             loadi 20[PC], t1
             loadConstantOrVariable2Reg(t2, scratch, t2)
-            writeBarrier(scratch, t2)
             storei scratch, TagOffset[propertyStorage, t1]
             storei t2, PayloadOffset[propertyStorage, t1]
+            writeBarrierOnOperand(1)
             dispatch(9)
         end)
 end
@@ -1141,11 +1147,11 @@ macro putByIdTransition(additionalChecks, getPropertyStorage)
         macro (propertyStorage, scratch)
             addp t1, propertyStorage, t3
             loadConstantOrVariable2Reg(t2, t1, t2)
-            writeBarrier(t1, t2)
             storei t1, TagOffset[t3]
             loadi 24[PC], t1
             storei t2, PayloadOffset[t3]
             storep t1, JSCell::m_structure[t0]
+            writeBarrierOnCell(t0, t1)
             dispatch(9)
         end)
 end
@@ -1300,6 +1306,7 @@ macro contiguousPutByVal(storeCallback)
 .storeResult:
     loadi 12[PC], t2
     storeCallback(t2, t1, t0, t3)
+    writeBarrierOnOperand(1)
     dispatch(5)
 
 .outOfBounds:
@@ -1356,7 +1363,6 @@ _llint_op_put_by_val:
             const tag = scratch
             const payload = operand
             loadConstantOrVariable2Reg(operand, tag, payload)
-            writeBarrier(tag, payload)
             storei tag, TagOffset[base, index, 8]
             storei payload, PayloadOffset[base, index, 8]
         end)
@@ -1368,9 +1374,9 @@ _llint_op_put_by_val:
 .opPutByValArrayStorageStoreResult:
     loadi 12[PC], t2
     loadConstantOrVariable2Reg(t2, t1, t2)
-    writeBarrier(t1, t2)
     storei t1, ArrayStorage::m_vector + TagOffset[t0, t3, 8]
     storei t2, ArrayStorage::m_vector + PayloadOffset[t0, t3, 8]
+    writeBarrierOnOperand(1)
     dispatch(5)
 
 .opPutByValArrayStorageEmpty:
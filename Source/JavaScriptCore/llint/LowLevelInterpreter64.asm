@@ -165,8 +165,14 @@ macro loadConstantOrVariableCell(index, value, slow)
     btqnz value, tagMask, slow
 end
 
-macro writeBarrier(value)
-    # Nothing to do, since we don't have a generational or incremental collector.
+# Dirties the card of the cell in the given operand of the current instruction.
+# Clobbers t1 and t2.
+macro writeBarrierOnOperand(cellOperand)
+    if GGC
+        loadisFromInstruction(cellOperand, t1)
+        loadConstantOrVariable(t1, t2)
+        writeBarrierOnCell(t2, t1)
+    end
 end
 
 macro valueProfile(value, profile)
@@ -839,8 +845,8 @@ _llint_op_init_global_const:
     loadisFromInstruction(2, t1)
     loadpFromInstruction(1, t0)
     loadConstantOrVariable(t1, t2)
-    writeBarrier(t2)
     storeq t2, [t0]
+    writeBarrierOnGlobalObject(t1, t3)
     dispatch(5)
 
 
@@ -851,8 +857,8 @@ _llint_op_init_global_const_check:
     loadpFromInstruction(1, t0)
     btbnz [t2], .opInitGlobalConstCheckSlow
     loadConstantOrVariable(t1, t2)
-    writeBarrier(t2)
     storeq t2, [t0]
+    writeBarrierOnGlobalObject(t1, t3)
     dispatch(5)
 .opInitGlobalConstCheckSlow:
     callSlowPath(_llint_slow_path_init_global_const_check)
@@ -948,8 +954,8 @@ macro putById(getPropertyStorage)
             bpneq JSCell::m_structure[t0], t1, .opPutByIdSlow
             loadisFromInstruction(5, t1)
             loadConstantOrVariable(t2, scratch)
-            writeBarrier(t0)
             storeq scratch, [propertyStorage, t1]
+            writeBarrierOnOperand(1)
             dispatch(9)
         end)
 end
@@ -981,10 +987,10 @@ macro putByIdTransition(additionalChecks, getPropertyStorage)
         macro (propertyStorage, scratch)
             addp t1, propertyStorage, t3
             loadConstantOrVariable(t2, t1)
-            writeBarrier(t1)
             storeq t1, [t3]
             loadpFromInstruction(6, t1)
             storep t1, JSCell::m_structure[t0]
+            writeBarrierOnCell(t0, t1)
             dispatch(9)
         end)
 end
@@ -1137,6 +1143,7 @@ macro contiguousPutByVal(storeCallback)
 .storeResult:
     loadisFromInstruction(3, t2)
     storeCallback(t2, t1, [t0, t3, 8])
+    writeBarrierOnOperand(1)
     dispatch(5)
 
 .outOfBounds:
@@ -1191,7 +1198,6 @@ _llint_op_put_by_val:
     contiguousPutByVal(
         macro (operand, scratch, address)
             loadConstantOrVariable(operand, scratch)
-            writeBarrier(scratch)
             storep scratch, address
         end)
 
@@ -1202,8 +1208,8 @@ _llint_op_put_by_val:
 .opPutByValArrayStorageStoreResult:
     loadisFromInstruction(3, t2)
     loadConstantOrVariable(t2, t1)
-    writeBarrier(t1)
     storeq t1, ArrayStorage::m_vector[t0, t3, 8]
+    writeBarrierOnOperand(1)
     dispatch(5)
 
 .opPutByValArrayStorageEmpty:
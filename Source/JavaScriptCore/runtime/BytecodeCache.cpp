@@ -0,0 +1,1109 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "BytecodeCache.h"
+
+#include "JSString.h"
+#include "Opcode.h"
+#include "RegExp.h"
+#include "SourceCode.h"
+#include "StrongInlines.h"
+#include "SymbolTable.h"
+#include "UnlinkedCodeBlock.h"
+#include <stdio.h>
+#include <string.h>
+#include <wtf/HashMap.h>
+#include <wtf/SHA1.h>
+#include <wtf/text/CString.h>
+
+#if OS(UNIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace JSC {
+
+static const char magic[8] = { 'J', 'S', 'C', 'B', 'C', 'O', 'D', 'E' };
+static const uint32_t formatVersion = 2;
+static const size_t headerSize = sizeof(magic) + 5 * sizeof(uint32_t);
+static const size_t entrySize = sourceDigestSize + 6 * sizeof(uint32_t);
+static const uint32_t nullStringLength = 0xffffffff;
+
+enum ValueTag {
+    EmptyValueTag,
+    UndefinedTag,
+    NullTag,
+    TrueTag,
+    FalseTag,
+    Int32Tag,
+    DoubleTag,
+    StringTag,
+    ConstantTag // A string that is also in the constant pool, by index.
+};
+
+enum CodeBlockFlags {
+    NeedsFullScopeChainFlag = 1 << 0,
+    UsesEvalFlag = 1 << 1,
+    IsNumericCompareFunctionFlag = 1 << 2,
+    IsStrictModeFlag = 1 << 3,
+    IsConstructorFlag = 1 << 4,
+    HasCapturedVariablesFlag = 1 << 5
+};
+
+enum FunctionExecutableFlags {
+    ForceUsesArgumentsFlag = 1 << 0,
+    IsInStrictContextFlag = 1 << 1,
+    FunctionHasCapturedVariablesFlag = 1 << 2
+};
+
+// FNV-1a.
+static uint32_t checksum(const uint8_t* data, size_t size, uint32_t hash = 2166136261u)
+{
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 16777619;
+    }
+    return hash;
+}
+
+// Changes whenever an opcode is added, removed, renumbered or resized.
+static uint32_t bytecodeFingerprint()
+{
+    uint32_t hash = checksum(0, 0);
+#define ADD_OPCODE_TO_FINGERPRINT(opcode, length) { \
+        uint32_t opcodeLength = length; \
+        hash = checksum(reinterpret_cast<const uint8_t*>(#opcode), sizeof(#opcode), hash); \
+        hash = checksum(reinterpret_cast<const uint8_t*>(&opcodeLength), sizeof(opcodeLength), hash); \
+    }
+    FOR_EACH_OPCODE_ID(ADD_OPCODE_TO_FINGERPRINT)
+#undef ADD_OPCODE_TO_FINGERPRINT
+    return hash;
+}
+
+// Bytecode compiled for the debugger or the profiler calls hooks that other
+// code must not.
+static bool containsDebuggerHooks(UnlinkedCodeBlock* codeBlock)
+{
+    const RefCountedArray<UnlinkedInstruction>& instructions = codeBlock->instructions();
+    for (size_t i = 0; i < instructions.size(); i += opcodeLengths[instructions[i].u.opcode]) {
+        OpcodeID opcode = instructions[i].u.opcode;
+        if (opcode == op_debug || opcode == op_profile_will_call || opcode == op_profile_did_call)
+            return true;
+    }
+    return false;
+}
+
+class BytecodeCacheEncoder {
+public:
+    BytecodeCacheEncoder(JSGlobalData& globalData, Vector<uint8_t>& data)
+        : m_globalData(globalData)
+        , m_data(data)
+    {
+    }
+
+    bool encodeCodeBlock(UnlinkedCodeBlock*, unsigned& offset);
+
+private:
+    // Bodies are decoded lazily or held weakly by their executables, and
+    // encoding a later one can allocate, so the queued ones are kept alive.
+    struct PendingBody {
+        PendingBody(size_t position, JSGlobalData& globalData, UnlinkedFunctionCodeBlock* codeBlock)
+            : position(position)
+            , codeBlock(globalData, codeBlock)
+        {
+        }
+
+        size_t position;
+        Strong<UnlinkedFunctionCodeBlock> codeBlock;
+    };
+
+    void write(const void* data, size_t size) { m_data.append(static_cast<const uint8_t*>(data), size); }
+    void writeUInt32(uint32_t value) { write(&value, sizeof(value)); }
+    void writeInt32(int32_t value) { write(&value, sizeof(value)); }
+    void writeBool(bool value) { writeUInt32(value); }
+    void writeString(const String&);
+    void writeIdentifier(const Identifier& identifier) { writeString(identifier.string()); }
+    bool writeValue(JSValue, UnlinkedCodeBlock* constantPoolOwner);
+    void writeSymbolTable(SharedSymbolTable*);
+    void writeFunctionExecutable(UnlinkedFunctionExecutable*, Vector<PendingBody>&);
+    UnlinkedFunctionCodeBlock* bodyFor(UnlinkedFunctionExecutable*, CodeSpecializationKind);
+
+    JSGlobalData& m_globalData;
+    Vector<uint8_t>& m_data;
+};
+
+void BytecodeCacheEncoder::writeString(const String& string)
+{
+    if (string.isNull()) {
+        writeUInt32(nullStringLength);
+        return;
+    }
+    writeUInt32(string.length());
+    writeBool(string.is8Bit());
+    if (string.is8Bit())
+        write(string.characters8(), string.length() * sizeof(LChar));
+    else
+        write(string.characters16(), string.length() * sizeof(UChar));
+}
+
+bool BytecodeCacheEncoder::writeValue(JSValue value, UnlinkedCodeBlock* constantPoolOwner)
+{
+    if (!value) {
+        writeUInt32(EmptyValueTag);
+        return true;
+    }
+    if (value.isUndefined()) {
+        writeUInt32(UndefinedTag);
+        return true;
+    }
+    if (value.isNull()) {
+        writeUInt32(NullTag);
+        return true;
+    }
+    if (value.isBoolean()) {
+        writeUInt32(value.asBoolean() ? TrueTag : FalseTag);
+        return true;
+    }
+    if (value.isInt32()) {
+        writeUInt32(Int32Tag);
+        writeInt32(value.asInt32());
+        return true;
+    }
+    if (value.isDouble()) {
+        double number = value.asDouble();
+        writeUInt32(DoubleTag);
+        write(&number, sizeof(number));
+        return true;
+    }
+    if (!value.isString())
+        return false;
+
+    // Constant buffers rely on the constant pool to keep their strings alive,
+    // so they must go on sharing them.
+    if (constantPoolOwner) {
+        const Vector<WriteBarrier<Unknown> >& constants = constantPoolOwner->constantRegisters();
+        for (size_t i = 0; i < constants.size(); ++i) {
+            if (constants[i].get() == value) {
+                writeUInt32(ConstantTag);
+                writeUInt32(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    writeUInt32(StringTag);
+    writeString(asString(value)->tryGetValue());
+    return true;
+}
+
+void BytecodeCacheEncoder::writeSymbolTable(SharedSymbolTable* symbolTable)
+{
+    writeBool(symbolTable);
+    if (!symbolTable)
+        return;
+
+    writeInt32(symbolTable->parameterCountIncludingThis());
+    writeBool(symbolTable->usesNonStrictEval());
+    writeInt32(symbolTable->captureStart());
+    writeInt32(symbolTable->captureEnd());
+
+    const SlowArgument* slowArguments = symbolTable->slowArguments();
+    writeBool(slowArguments);
+    if (slowArguments) {
+        for (int i = 0; i < symbolTable->parameterCount(); ++i) {
+            writeUInt32(slowArguments[i].status);
+            writeInt32(slowArguments[i].index);
+        }
+    }
+
+    writeUInt32(symbolTable->size());
+    SymbolTable::iterator end = symbolTable->end();
+    for (SymbolTable::iterator it = symbolTable->begin(); it != end; ++it) {
+        writeString(String(it->key));
+        writeInt32(it->value.getIndex());
+        writeUInt32(it->value.getAttributes());
+    }
+}
+
+UnlinkedFunctionCodeBlock* BytecodeCacheEncoder::bodyFor(UnlinkedFunctionExecutable* executable, CodeSpecializationKind kind)
+{
+    UnlinkedFunctionCodeBlock* codeBlock = kind == CodeForCall ? executable->m_codeBlockForCall.get() : executable->m_codeBlockForConstruct.get();
+    if (codeBlock)
+        return codeBlock;
+
+    // Keep the bodies that this process read but never ran.
+    unsigned offset = kind == CodeForCall ? executable->m_bytecodeCacheOffsetForCall : executable->m_bytecodeCacheOffsetForConstruct;
+    if (executable->m_bytecodeCacheFile && offset)
+        return executable->m_bytecodeCacheFile->functionCodeBlock(m_globalData, offset);
+    return 0;
+}
+
+void BytecodeCacheEncoder::writeFunctionExecutable(UnlinkedFunctionExecutable* executable, Vector<PendingBody>& pendingBodies)
+{
+    unsigned flags = 0;
+    if (executable->m_forceUsesArguments)
+        flags |= ForceUsesArgumentsFlag;
+    if (executable->m_isInStrictContext)
+        flags |= IsInStrictContextFlag;
+    if (executable->m_hasCapturedVariables)
+        flags |= FunctionHasCapturedVariablesFlag;
+
+    writeUInt32(executable->m_numCapturedVariables);
+    writeUInt32(flags);
+    writeIdentifier(executable->m_name);
+    writeIdentifier(executable->m_inferredName);
+    FunctionParameters& parameters = *executable->m_parameters;
+    writeUInt32(parameters.size());
+    for (size_t i = 0; i < parameters.size(); ++i)
+        writeIdentifier(parameters[i]);
+    writeUInt32(executable->m_firstLineOffset);
+    writeUInt32(executable->m_lineCount);
+    writeUInt32(executable->m_startOffset);
+    writeUInt32(executable->m_sourceLength);
+    writeUInt32(executable->m_features);
+    writeUInt32(executable->m_functionNameIsInScopeToggle);
+
+    for (unsigned i = 0; i < 2; ++i) {
+        if (UnlinkedFunctionCodeBlock* body = bodyFor(executable, i ? CodeForConstruct : CodeForCall))
+            pendingBodies.append(PendingBody(m_data.size(), m_globalData, body));
+        writeUInt32(0);
+    }
+}
+
+bool BytecodeCacheEncoder::encodeCodeBlock(UnlinkedCodeBlock* codeBlock, unsigned& offset)
+{
+    if (containsDebuggerHooks(codeBlock))
+        return false;
+
+    offset = m_data.size();
+
+    unsigned flags = 0;
+    if (codeBlock->m_needsFullScopeChain)
+        flags |= NeedsFullScopeChainFlag;
+    if (codeBlock->m_usesEval)
+        flags |= UsesEvalFlag;
+    if (codeBlock->m_isNumericCompareFunction)
+        flags |= IsNumericCompareFunctionFlag;
+    if (codeBlock->m_isStrictMode)
+        flags |= IsStrictModeFlag;
+    if (codeBlock->m_isConstructor)
+        flags |= IsConstructorFlag;
+    if (codeBlock->m_hasCapturedVariables)
+        flags |= HasCapturedVariablesFlag;
+
+    writeUInt32(codeBlock->m_codeType);
+    writeUInt32(flags);
+    writeInt32(codeBlock->m_numParameters);
+    writeInt32(codeBlock->m_thisRegister);
+    writeInt32(codeBlock->m_argumentsRegister);
+    writeInt32(codeBlock->m_activationRegister);
+    writeInt32(codeBlock->m_numVars);
+    writeInt32(codeBlock->m_numCapturedVars);
+    writeInt32(codeBlock->m_numCalleeRegisters);
+    writeUInt32(codeBlock->m_firstLine);
+    writeUInt32(codeBlock->m_lineCount);
+    writeUInt32(codeBlock->m_features);
+    writeUInt32(codeBlock->m_resolveOperationCount);
+    writeUInt32(codeBlock->m_putToBaseOperationCount);
+    writeUInt32(codeBlock->m_arrayProfileCount);
+    writeUInt32(codeBlock->m_arrayAllocationProfileCount);
+    writeUInt32(codeBlock->m_valueProfileCount);
+    writeUInt32(codeBlock->m_llintCallLinkInfoCount);
+
+    const RefCountedArray<UnlinkedInstruction>& instructions = codeBlock->m_unlinkedInstructions;
+    writeUInt32(instructions.size());
+    write(instructions.data(), instructions.size() * sizeof(UnlinkedInstruction));
+
+    writeUInt32(codeBlock->m_jumpTargets.size());
+    write(codeBlock->m_jumpTargets.data(), codeBlock->m_jumpTargets.size() * sizeof(unsigned));
+
+    writeUInt32(codeBlock->m_identifiers.size());
+    for (size_t i = 0; i < codeBlock->m_identifiers.size(); ++i)
+        writeIdentifier(codeBlock->m_identifiers[i]);
+
+    bool succeeded = true;
+    writeUInt32(codeBlock->m_constantRegisters.size());
+    for (size_t i = 0; i < codeBlock->m_constantRegisters.size(); ++i)
+        succeeded &= writeValue(codeBlock->m_constantRegisters[i].get(), 0);
+
+    // Function executables can be named by more than one list, so they are
+    // written once each, and referred to by index.
+    Vector<UnlinkedFunctionExecutable*> executables;
+    HashMap<UnlinkedFunctionExecutable*, unsigned> executableIndices;
+    Vector<UnlinkedFunctionExecutable*> referencedExecutables;
+    for (size_t i = 0; i < codeBlock->m_functionDecls.size(); ++i)
+        referencedExecutables.append(codeBlock->m_functionDecls[i].get());
+    for (size_t i = 0; i < codeBlock->m_functionExprs.size(); ++i)
+        referencedExecutables.append(codeBlock->m_functionExprs[i].get());
+    if (codeBlock->m_codeType == GlobalCode) {
+        const UnlinkedProgramCodeBlock::FunctionDeclations& declarations = jsCast<UnlinkedProgramCodeBlock*>(codeBlock)->functionDeclarations();
+        for (size_t i = 0; i < declarations.size(); ++i)
+            referencedExecutables.append(declarations[i].second.get());
+    }
+    for (size_t i = 0; i < referencedExecutables.size(); ++i) {
+        if (executableIndices.add(referencedExecutables[i], executables.size()).isNewEntry)
+            executables.append(referencedExecutables[i]);
+    }
+
+    Vector<PendingBody> pendingBodies;
+    writeUInt32(executables.size());
+    for (size_t i = 0; i < executables.size(); ++i)
+        writeFunctionExecutable(executables[i], pendingBodies);
+    writeUInt32(codeBlock->m_functionDecls.size());
+    for (size_t i = 0; i < codeBlock->m_functionDecls.size(); ++i)
+        writeUInt32(executableIndices.get(codeBlock->m_functionDecls[i].get()));
+    writeUInt32(codeBlock->m_functionExprs.size());
+    for (size_t i = 0; i < codeBlock->m_functionExprs.size(); ++i)
+        writeUInt32(executableIndices.get(codeBlock->m_functionExprs[i].get()));
+
+    writeSymbolTable(codeBlock->m_symbolTable.get());
+
+    writeUInt32(codeBlock->m_lineInfo.size());
+    for (size_t i = 0; i < codeBlock->m_lineInfo.size(); ++i) {
+        writeUInt32(codeBlock->m_lineInfo[i].instructionOffset);
+        writeInt32(codeBlock->m_lineInfo[i].lineNumber);
+    }
+
+    writeUInt32(codeBlock->m_propertyAccessInstructions.size());
+    write(codeBlock->m_propertyAccessInstructions.data(), codeBlock->m_propertyAccessInstructions.size() * sizeof(unsigned));
+
+    writeUInt32(codeBlock->m_expressionInfo.size());
+    for (size_t i = 0; i < codeBlock->m_expressionInfo.size(); ++i) {
+        const ExpressionRangeInfo& info = codeBlock->m_expressionInfo[i];
+        writeUInt32(info.instructionOffset);
+        writeUInt32(info.divotPoint);
+        writeUInt32(info.startOffset);
+        writeUInt32(info.endOffset);
+    }
+
+    UnlinkedCodeBlock::RareData* rareData = codeBlock->m_rareData.get();
+    writeBool(rareData);
+    if (rareData) {
+        writeUInt32(rareData->m_exceptionHandlers.size());
+        for (size_t i = 0; i < rareData->m_exceptionHandlers.size(); ++i) {
+            const UnlinkedHandlerInfo& handler = rareData->m_exceptionHandlers[i];
+            writeUInt32(handler.start);
+            writeUInt32(handler.end);
+            writeUInt32(handler.target);
+            writeUInt32(handler.scopeDepth);
+        }
+
+        writeUInt32(rareData->m_regexps.size());
+        for (size_t i = 0; i < rareData->m_regexps.size(); ++i) {
+            RegExp* regExp = rareData->m_regexps[i].get();
+            unsigned regExpFlags = NoFlags;
+            if (regExp->global())
+                regExpFlags |= FlagGlobal;
+            if (regExp->ignoreCase())
+                regExpFlags |= FlagIgnoreCase;
+            if (regExp->multiline())
+                regExpFlags |= FlagMultiline;
+            writeString(regExp->pattern());
+            writeUInt32(regExpFlags);
+        }
+
+        writeUInt32(rareData->m_constantBuffers.size());
+        for (size_t i = 0; i < rareData->m_constantBuffers.size(); ++i) {
+            const UnlinkedCodeBlock::ConstantBuffer& buffer = rareData->m_constantBuffers[i];
+            writeUInt32(buffer.size());
+            for (size_t j = 0; j < buffer.size(); ++j)
+                succeeded &= writeValue(buffer[j], codeBlock);
+        }
+
+        const Vector<UnlinkedSimpleJumpTable>* simpleJumpTables[] = { &rareData->m_immediateSwitchJumpTables, &rareData->m_characterSwitchJumpTables };
+        for (size_t i = 0; i < WTF_ARRAY_LENGTH(simpleJumpTables); ++i) {
+            const Vector<UnlinkedSimpleJumpTable>& tables = *simpleJumpTables[i];
+            writeUInt32(tables.size());
+            for (size_t j = 0; j < tables.size(); ++j) {
+                writeInt32(tables[j].min);
+                writeUInt32(tables[j].branchOffsets.size());
+                write(tables[j].branchOffsets.data(), tables[j].branchOffsets.size() * sizeof(int32_t));
+            }
+        }
+
+        writeUInt32(rareData->m_stringSwitchJumpTables.size());
+        for (size_t i = 0; i < rareData->m_stringSwitchJumpTables.size(); ++i) {
+            const UnlinkedStringJumpTable::StringOffsetTable& table = rareData->m_stringSwitchJumpTables[i].offsetTable;
+            writeUInt32(table.size());
+            UnlinkedStringJumpTable::StringOffsetTable::const_iterator end = table.end();
+            for (UnlinkedStringJumpTable::StringOffsetTable::const_iterator it = table.begin(); it != end; ++it) {
+                writeString(String(it->key));
+                writeInt32(it->value);
+            }
+        }
+    }
+
+    if (codeBlock->m_codeType == GlobalCode) {
+        UnlinkedProgramCodeBlock* programCodeBlock = jsCast<UnlinkedProgramCodeBlock*>(codeBlock);
+        const UnlinkedProgramCodeBlock::VariableDeclations& variables = programCodeBlock->variableDeclarations();
+        writeUInt32(variables.size());
+        for (size_t i = 0; i < variables.size(); ++i) {
+            writeIdentifier(variables[i].first);
+            writeBool(variables[i].second);
+        }
+        const UnlinkedProgramCodeBlock::FunctionDeclations& functions = programCodeBlock->functionDeclarations();
+        writeUInt32(functions.size());
+        for (size_t i = 0; i < functions.size(); ++i) {
+            writeIdentifier(functions[i].first);
+            writeUInt32(executableIndices.get(functions[i].second.get()));
+        }
+    }
+
+    if (!succeeded) {
+        m_data.shrink(offset);
+        return false;
+    }
+
+    // A body that cannot be cached is parsed again when it is first called.
+    for (size_t i = 0; i < pendingBodies.size(); ++i) {
+        unsigned bodyOffset;
+        if (encodeCodeBlock(pendingBodies[i].codeBlock.get(), bodyOffset))
+            memcpy(m_data.data() + pendingBodies[i].position, &bodyOffset, sizeof(bodyOffset));
+    }
+    return true;
+}
+
+class BytecodeCacheDecoder {
+public:
+    BytecodeCacheDecoder(JSGlobalData& globalData, BytecodeCacheFile* file, const uint8_t* data, size_t size, unsigned offset)
+        : m_globalData(globalData)
+        , m_file(file)
+        , m_data(data)
+        , m_size(size)
+        , m_position(offset)
+        , m_failed(offset > size)
+    {
+    }
+
+    UnlinkedProgramCodeBlock* decodeProgramCodeBlock();
+    UnlinkedFunctionCodeBlock* decodeFunctionCodeBlock();
+
+private:
+    typedef Vector<Strong<UnlinkedFunctionExecutable> > ExecutableVector;
+
+    void read(void*, size_t);
+    uint32_t readUInt32()
+    {
+        uint32_t value;
+        read(&value, sizeof(value));
+        return value;
+    }
+    int32_t readInt32()
+    {
+        int32_t value;
+        read(&value, sizeof(value));
+        return value;
+    }
+    bool readBool() { return readUInt32(); }
+    uint32_t readCount(size_t minimumElementSize);
+    String readString();
+    Identifier readIdentifier();
+    JSValue readValue(UnlinkedCodeBlock* constantPoolOwner);
+    UnlinkedFunctionExecutable* readFunctionExecutable(ExecutableVector&);
+    UnlinkedFunctionExecutable* readExecutableIndex(const ExecutableVector&);
+    void readSymbolTable(SharedSymbolTable*);
+
+    bool readHeader(CodeType, ExecutableInfo&, unsigned& flags);
+    bool readCodeBlock(UnlinkedCodeBlock*, unsigned flags, ExecutableVector&);
+
+    JSGlobalData& m_globalData;
+    BytecodeCacheFile* m_file;
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_position;
+    bool m_failed;
+};
+
+void BytecodeCacheDecoder::read(void* buffer, size_t size)
+{
+    if (m_failed || size > m_size - m_position) {
+        m_failed = true;
+        memset(buffer, 0, size);
+        return;
+    }
+    memcpy(buffer, m_data + m_position, size);
+    m_position += size;
+}
+
+// Keeps a damaged count from turning into a huge allocation.
+uint32_t BytecodeCacheDecoder::readCount(size_t minimumElementSize)
+{
+    uint32_t count = readUInt32();
+    if (m_failed || count > (m_size - m_position) / minimumElementSize) {
+        m_failed = true;
+        return 0;
+    }
+    return count;
+}
+
+String BytecodeCacheDecoder::readString()
+{
+    uint32_t length = readUInt32();
+    if (length == nullStringLength)
+        return String();
+    bool is8Bit = readBool();
+    size_t characterSize = is8Bit ? sizeof(LChar) : sizeof(UChar);
+    if (m_failed || length > (m_size - m_position) / characterSize) {
+        m_failed = true;
+        return String();
+    }
+    if (is8Bit) {
+        LChar* characters;
+        String string = String::createUninitialized(length, characters);
+        read(characters, length * sizeof(LChar));
+        return string;
+    }
+    UChar* characters;
+    String string = String::createUninitialized(length, characters);
+    read(characters, length * sizeof(UChar));
+    return string;
+}
+
+Identifier BytecodeCacheDecoder::readIdentifier()
+{
+    String string = readString();
+    if (string.isNull())
+        return Identifier();
+    return Identifier(&m_globalData, string);
+}
+
+JSValue BytecodeCacheDecoder::readValue(UnlinkedCodeBlock* constantPoolOwner)
+{
+    switch (readUInt32()) {
+    case EmptyValueTag:
+        return JSValue();
+    case UndefinedTag:
+        return jsUndefined();
+    case NullTag:
+        return jsNull();
+    case TrueTag:
+        return jsBoolean(true);
+    case FalseTag:
+        return jsBoolean(false);
+    case Int32Tag:
+        return jsNumber(readInt32());
+    case DoubleTag: {
+        double number;
+        read(&number, sizeof(number));
+        return JSValue(JSValue::EncodeAsDouble, number);
+    }
+    case StringTag:
+        return jsString(&m_globalData, readString());
+    case ConstantTag: {
+        uint32_t index = readUInt32();
+        if (!constantPoolOwner || index >= constantPoolOwner->numberOfConstantRegisters())
+            break;
+        return constantPoolOwner->getConstant(FirstConstantRegisterIndex + index);
+    }
+    }
+    m_failed = true;
+    return JSValue();
+}
+
+void BytecodeCacheDecoder::readSymbolTable(SharedSymbolTable* symbolTable)
+{
+    if (!readBool())
+        return;
+    if (!symbolTable) {
+        m_failed = true;
+        return;
+    }
+
+    symbolTable->setParameterCountIncludingThis(readInt32());
+    symbolTable->setUsesNonStrictEval(readBool());
+    symbolTable->setCaptureStart(readInt32());
+    symbolTable->setCaptureEnd(readInt32());
+
+    if (readBool()) {
+        int parameterCount = symbolTable->parameterCount();
+        if (parameterCount < 0 || static_cast<size_t>(parameterCount) > (m_size - m_position) / (2 * sizeof(uint32_t))) {
+            m_failed = true;
+            return;
+        }
+        OwnArrayPtr<SlowArgument> slowArguments = adoptArrayPtr(new SlowArgument[parameterCount]);
+        for (int i = 0; i < parameterCount; ++i) {
+            slowArguments[i].status = static_cast<SlowArgument::Status>(readUInt32());
+            slowArguments[i].index = readInt32();
+        }
+        symbolTable->setSlowArguments(slowArguments.release());
+    }
+
+    uint32_t size = readCount(3 * sizeof(uint32_t));
+    for (uint32_t i = 0; i < size && !m_failed; ++i) {
+        Identifier name = readIdentifier();
+        int index = readInt32();
+        unsigned attributes = readUInt32();
+        if (m_failed || name.isNull())
+            break;
+        symbolTable->add(name.impl(), SymbolTableEntry(index, attributes));
+    }
+}
+
+UnlinkedFunctionExecutable* BytecodeCacheDecoder::readFunctionExecutable(ExecutableVector& executables)
+{
+    unsigned numCapturedVariables = readUInt32();
+    unsigned flags = readUInt32();
+    Identifier name = readIdentifier();
+    Identifier inferredName = readIdentifier();
+    RefPtr<FunctionParameters> parameters = FunctionParameters::create(0);
+    uint32_t parameterCount = readCount(sizeof(uint32_t));
+    for (uint32_t i = 0; i < parameterCount && !m_failed; ++i)
+        parameters->append(readIdentifier());
+    if (m_failed)
+        return 0;
+
+    UnlinkedFunctionExecutable* executable = new (NotNull, allocateCell<UnlinkedFunctionExecutable>(m_globalData.heap)) UnlinkedFunctionExecutable(&m_globalData, m_globalData.unlinkedFunctionExecutableStructure.get());
+    executable->m_numCapturedVariables = numCapturedVariables;
+    executable->m_forceUsesArguments = flags & ForceUsesArgumentsFlag;
+    executable->m_isInStrictContext = flags & IsInStrictContextFlag;
+    executable->m_hasCapturedVariables = flags & FunctionHasCapturedVariablesFlag;
+    executable->m_name = name;
+    executable->m_inferredName = inferredName;
+    executable->m_parameters = parameters.release();
+    executable->m_firstLineOffset = readUInt32();
+    executable->m_lineCount = readUInt32();
+    executable->m_startOffset = readUInt32();
+    executable->m_sourceLength = readUInt32();
+    executable->m_features = readUInt32();
+    executable->m_functionNameIsInScopeToggle = readUInt32() ? FunctionNameIsInScope : FunctionNameIsNotInScope;
+    executable->m_bytecodeCacheFile = m_file;
+    executable->m_bytecodeCacheOffsetForCall = readUInt32();
+    executable->m_bytecodeCacheOffsetForConstruct = readUInt32();
+    executable->finishCreation(m_globalData);
+    executables.append(Strong<UnlinkedFunctionExecutable>(m_globalData, executable));
+    return executable;
+}
+
+UnlinkedFunctionExecutable* BytecodeCacheDecoder::readExecutableIndex(const ExecutableVector& executables)
+{
+    uint32_t index = readUInt32();
+    if (index >= executables.size()) {
+        m_failed = true;
+        return 0;
+    }
+    return executables[index].get();
+}
+
+bool BytecodeCacheDecoder::readHeader(CodeType expectedCodeType, ExecutableInfo& info, unsigned& flags)
+{
+    CodeType codeType = static_cast<CodeType>(readUInt32());
+    flags = readUInt32();
+    info = ExecutableInfo(flags & NeedsFullScopeChainFlag, flags & UsesEvalFlag, flags & IsStrictModeFlag, flags & IsConstructorFlag);
+    return !m_failed && codeType == expectedCodeType;
+}
+
+bool BytecodeCacheDecoder::readCodeBlock(UnlinkedCodeBlock* codeBlock, unsigned flags, ExecutableVector& executables)
+{
+    codeBlock->m_isNumericCompareFunction = flags & IsNumericCompareFunctionFlag;
+    codeBlock->m_hasCapturedVariables = flags & HasCapturedVariablesFlag;
+    codeBlock->m_numParameters = readInt32();
+    codeBlock->m_thisRegister = readInt32();
+    codeBlock->m_argumentsRegister = readInt32();
+    codeBlock->m_activationRegister = readInt32();
+    codeBlock->m_numVars = readInt32();
+    codeBlock->m_numCapturedVars = readInt32();
+    codeBlock->m_numCalleeRegisters = readInt32();
+    codeBlock->m_firstLine = readUInt32();
+    codeBlock->m_lineCount = readUInt32();
+    codeBlock->m_features = readUInt32();
+    codeBlock->m_resolveOperationCount = readUInt32();
+    codeBlock->m_putToBaseOperationCount = readUInt32();
+    codeBlock->m_arrayProfileCount = readUInt32();
+    codeBlock->m_arrayAllocationProfileCount = readUInt32();
+    codeBlock->m_valueProfileCount = readUInt32();
+    codeBlock->m_llintCallLinkInfoCount = readUInt32();
+
+    Vector<UnlinkedInstruction> instructions(readCount(sizeof(UnlinkedInstruction)));
+    read(instructions.data(), instructions.size() * sizeof(UnlinkedInstruction));
+    codeBlock->m_unlinkedInstructions = RefCountedArray<UnlinkedInstruction>(instructions);
+
+    codeBlock->m_jumpTargets.resize(readCount(sizeof(unsigned)));
+    read(codeBlock->m_jumpTargets.data(), codeBlock->m_jumpTargets.size() * sizeof(unsigned));
+
+    uint32_t identifierCount = readCount(sizeof(uint32_t));
+    codeBlock->m_identifiers.reserveInitialCapacity(identifierCount);
+    for (uint32_t i = 0; i < identifierCount && !m_failed; ++i)
+        codeBlock->addIdentifier(readIdentifier());
+
+    uint32_t constantCount = readCount(sizeof(uint32_t));
+    for (uint32_t i = 0; i < constantCount && !m_failed; ++i)
+        codeBlock->addConstant(readValue(0));
+
+    uint32_t executableCount = readCount(sizeof(uint32_t));
+    for (uint32_t i = 0; i < executableCount && !m_failed; ++i)
+        readFunctionExecutable(executables);
+    uint32_t functionDeclCount = readCount(sizeof(uint32_t));
+    for (uint32_t i = 0; i < functionDeclCount && !m_failed; ++i) {
+        if (UnlinkedFunctionExecutable* executable = readExecutableIndex(executables))
+            codeBlock->addFunctionDecl(executable);
+    }
+    uint32_t functionExprCount = readCount(sizeof(uint32_t));
+    for (uint32_t i = 0; i < functionExprCount && !m_failed; ++i) {
+        if (UnlinkedFunctionExecutable* executable = readExecutableIndex(executables))
+            codeBlock->addFunctionExpr(executable);
+    }
+
+    readSymbolTable(codeBlock->symbolTable());
+
+    uint32_t lineInfoCount = readCount(2 * sizeof(uint32_t));
+    codeBlock->m_lineInfo.reserveInitialCapacity(lineInfoCount);
+    for (uint32_t i = 0; i < lineInfoCount && !m_failed; ++i) {
+        LineInfo info;
+        info.instructionOffset = readUInt32();
+        info.lineNumber = readInt32();
+        codeBlock->m_lineInfo.append(info);
+    }
+
+    codeBlock->m_propertyAccessInstructions.resize(readCount(sizeof(unsigned)));
+    read(codeBlock->m_propertyAccessInstructions.data(), codeBlock->m_propertyAccessInstructions.size() * sizeof(unsigned));
+
+    uint32_t expressionInfoCount = readCount(4 * sizeof(uint32_t));
+    codeBlock->m_expressionInfo.reserveInitialCapacity(expressionInfoCount);
+    for (uint32_t i = 0; i < expressionInfoCount && !m_failed; ++i) {
+        ExpressionRangeInfo info;
+        info.instructionOffset = readUInt32();
+        info.divotPoint = readUInt32();
+        info.startOffset = readUInt32();
+        info.endOffset = readUInt32();
+        codeBlock->m_expressionInfo.append(info);
+    }
+
+    if (readBool() && !m_failed) {
+        codeBlock->createRareDataIfNecessary();
+        UnlinkedCodeBlock::RareData* rareData = codeBlock->m_rareData.get();
+
+        uint32_t handlerCount = readCount(4 * sizeof(uint32_t));
+        for (uint32_t i = 0; i < handlerCount && !m_failed; ++i) {
+            UnlinkedHandlerInfo handler;
+            handler.start = readUInt32();
+            handler.end = readUInt32();
+            handler.target = readUInt32();
+            handler.scopeDepth = readUInt32();
+            rareData->m_exceptionHandlers.append(handler);
+        }
+
+        uint32_t regExpCount = readCount(2 * sizeof(uint32_t));
+        for (uint32_t i = 0; i < regExpCount && !m_failed; ++i) {
+            String pattern = readString();
+            RegExpFlags regExpFlags = static_cast<RegExpFlags>(readUInt32() & (FlagGlobal | FlagIgnoreCase | FlagMultiline));
+            if (m_failed || pattern.isNull())
+                break;
+            codeBlock->addRegExp(RegExp::create(m_globalData, pattern, regExpFlags));
+        }
+
+        uint32_t constantBufferCount = readCount(sizeof(uint32_t));
+        for (uint32_t i = 0; i < constantBufferCount && !m_failed; ++i) {
+            uint32_t length = readCount(sizeof(uint32_t));
+            UnlinkedCodeBlock::ConstantBuffer& buffer = codeBlock->constantBuffer(codeBlock->addConstantBuffer(length));
+            for (uint32_t j = 0; j < length && !m_failed; ++j)
+                buffer[j] = readValue(codeBlock);
+        }
+
+        Vector<UnlinkedSimpleJumpTable>* simpleJumpTables[] = { &rareData->m_immediateSwitchJumpTables, &rareData->m_characterSwitchJumpTables };
+        for (size_t i = 0; i < WTF_ARRAY_LENGTH(simpleJumpTables); ++i) {
+            uint32_t tableCount = readCount(2 * sizeof(uint32_t));
+            for (uint32_t j = 0; j < tableCount && !m_failed; ++j) {
+                simpleJumpTables[i]->append(UnlinkedSimpleJumpTable());
+                UnlinkedSimpleJumpTable& table = simpleJumpTables[i]->last();
+                table.min = readInt32();
+                table.branchOffsets.resize(readCount(sizeof(int32_t)));
+                read(table.branchOffsets.data(), table.branchOffsets.size() * sizeof(int32_t));
+            }
+        }
+
+        uint32_t stringTableCount = readCount(sizeof(uint32_t));
+        for (uint32_t i = 0; i < stringTableCount && !m_failed; ++i) {
+            rareData->m_stringSwitchJumpTables.append(UnlinkedStringJumpTable());
+            UnlinkedStringJumpTable::StringOffsetTable& table = rareData->m_stringSwitchJumpTables.last().offsetTable;
+            uint32_t size = readCount(2 * sizeof(uint32_t));
+            for (uint32_t j = 0; j < size && !m_failed; ++j) {
+                // Keys are compared by pointer, so they have to be atomic.
+                Identifier key = readIdentifier();
+                int32_t offset = readInt32();
+                if (m_failed || key.isNull())
+                    break;
+                table.add(key.impl(), offset);
+            }
+        }
+    }
+
+    return !m_failed;
+}
+
+UnlinkedProgramCodeBlock* BytecodeCacheDecoder::decodeProgramCodeBlock()
+{
+    ExecutableInfo info(false, false, false, false);
+    unsigned flags;
+    if (!readHeader(GlobalCode, info, flags))
+        return 0;
+
+    UnlinkedProgramCodeBlock* codeBlock = UnlinkedProgramCodeBlock::create(&m_globalData, info);
+    ExecutableVector executables;
+    if (!readCodeBlock(codeBlock, flags, executables))
+        return 0;
+
+    uint32_t variableCount = readCount(2 * sizeof(uint32_t));
+    for (uint32_t i = 0; i < variableCount && !m_failed; ++i) {
+        Identifier name = readIdentifier();
+        codeBlock->addVariableDeclaration(name, readBool());
+    }
+    uint32_t functionCount = readCount(2 * sizeof(uint32_t));
+    for (uint32_t i = 0; i < functionCount && !m_failed; ++i) {
+        Identifier name = readIdentifier();
+        if (UnlinkedFunctionExecutable* executable = readExecutableIndex(executables))
+            codeBlock->addFunctionDeclaration(m_globalData, name, executable);
+    }
+
+    if (m_failed)
+        return 0;
+    return codeBlock;
+}
+
+UnlinkedFunctionCodeBlock* BytecodeCacheDecoder::decodeFunctionCodeBlock()
+{
+    ExecutableInfo info(false, false, false, false);
+    unsigned flags;
+    if (!readHeader(FunctionCode, info, flags))
+        return 0;
+
+    UnlinkedFunctionCodeBlock* codeBlock = UnlinkedFunctionCodeBlock::create(&m_globalData, FunctionCode, info);
+    ExecutableVector executables;
+    if (!readCodeBlock(codeBlock, flags, executables))
+        return 0;
+    return codeBlock;
+}
+
+BytecodeCacheFile::BytecodeCacheFile(const uint8_t* data, size_t size, bool isMapped)
+    : m_data(data)
+    , m_size(size)
+    , m_isMapped(isMapped)
+    , m_codeBlocks(0)
+    , m_codeBlocksSize(0)
+{
+}
+
+BytecodeCacheFile::~BytecodeCacheFile()
+{
+#if OS(UNIX)
+    if (m_isMapped) {
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+        return;
+    }
+#endif
+    fastFree(const_cast<uint8_t*>(m_data));
+}
+
+PassRefPtr<BytecodeCacheFile> BytecodeCacheFile::open(const char* path)
+{
+    RefPtr<BytecodeCacheFile> file;
+#if OS(UNIX)
+    int fd = ::open(path, O_RDONLY);
+    if (fd == -1)
+        return 0;
+    struct stat status;
+    if (fstat(fd, &status) || status.st_size < static_cast<off_t>(headerSize)) {
+        close(fd);
+        return 0;
+    }
+    void* data = mmap(0, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return 0;
+    file = adoptRef(new BytecodeCacheFile(static_cast<const uint8_t*>(data), status.st_size, true));
+#else
+    FILE* stream = fopen(path, "rb");
+    if (!stream)
+        return 0;
+    Vector<uint8_t> contents;
+    uint8_t buffer[16 * 1024];
+    while (size_t count = fread(buffer, 1, sizeof(buffer), stream))
+        contents.append(buffer, count);
+    fclose(stream);
+    if (contents.size() < headerSize)
+        return 0;
+    uint8_t* data = static_cast<uint8_t*>(fastMalloc(contents.size()));
+    memcpy(data, contents.data(), contents.size());
+    file = adoptRef(new BytecodeCacheFile(data, contents.size(), false));
+#endif
+
+    if (!file->readEntries())
+        return 0;
+    return file.release();
+}
+
+bool BytecodeCacheFile::readEntries()
+{
+    if (memcmp(m_data, magic, sizeof(magic)))
+        return false;
+
+    uint32_t header[5];
+    memcpy(header, m_data + sizeof(magic), sizeof(header));
+    uint32_t version = header[0];
+    uint32_t fingerprint = header[1];
+    uint32_t entryCount = header[2];
+    uint32_t dataOffset = header[3];
+    uint32_t dataSize = header[4];
+    if (version != formatVersion || fingerprint != bytecodeFingerprint())
+        return false;
+    if (entryCount > (m_size - headerSize) / entrySize || dataOffset < headerSize + entryCount * entrySize
+        || dataOffset > m_size || dataSize > m_size - dataOffset)
+        return false;
+
+    m_codeBlocks = m_data + dataOffset;
+    m_codeBlocksSize = dataSize;
+    m_entries.reserveInitialCapacity(entryCount);
+    for (uint32_t i = 0; i < entryCount; ++i) {
+        const uint8_t* entryData = m_data + headerSize + i * entrySize;
+        uint32_t fields[6];
+        memcpy(fields, entryData + sourceDigestSize, sizeof(fields));
+        Entry entry = { { 0 }, fields[0], fields[1], fields[2], fields[3], fields[4], fields[5], false };
+        memcpy(entry.sourceDigest, entryData, sourceDigestSize);
+        if (entry.offset > dataSize || entry.size > dataSize - entry.offset)
+            return false;
+        m_entries.append(entry);
+    }
+    return true;
+}
+
+static void computeSourceDigest(const String& source, uint8_t* digest)
+{
+    SHA1 sha1;
+    sha1.addBytes(source.utf8());
+    Vector<uint8_t, 20> result;
+    sha1.computeHash(result);
+    memcpy(digest, result.data(), sourceDigestSize);
+}
+
+UnlinkedProgramCodeBlock* BytecodeCacheFile::programCodeBlock(JSGlobalData& globalData, const SourceCode& source, JSParserStrictness strictness)
+{
+    String sourceString = source.toString();
+    if (sourceString.isNull())
+        return 0;
+    unsigned sourceStringHash = sourceString.impl()->hash();
+
+    uint8_t sourceDigest[sourceDigestSize];
+    bool hasSourceDigest = false;
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        Entry& entry = m_entries[i];
+        if (entry.sourceLength != sourceString.length() || entry.sourceStringHash != sourceStringHash || entry.strictness != static_cast<unsigned>(strictness))
+            continue;
+        if (!hasSourceDigest) {
+            computeSourceDigest(sourceString, sourceDigest);
+            hasSourceDigest = true;
+        }
+        if (memcmp(entry.sourceDigest, sourceDigest, sourceDigestSize))
+            continue;
+
+        if (!entry.isVerified) {
+            if (checksum(m_codeBlocks + entry.offset, entry.size) != entry.checksum)
+                return 0;
+            entry.isVerified = true;
+        }
+        BytecodeCacheDecoder decoder(globalData, this, m_codeBlocks, entry.offset + entry.size, entry.offset);
+        return decoder.decodeProgramCodeBlock();
+    }
+    return 0;
+}
+
+// The offset comes from an executable that was decoded from a verified entry,
+// and the entry holds the bodies of its functions.
+UnlinkedFunctionCodeBlock* BytecodeCacheFile::functionCodeBlock(JSGlobalData& globalData, unsigned offset)
+{
+    BytecodeCacheDecoder decoder(globalData, this, m_codeBlocks, m_codeBlocksSize, offset);
+    return decoder.decodeFunctionCodeBlock();
+}
+
+BytecodeCacheWriter::BytecodeCacheWriter(JSGlobalData& globalData)
+    : m_globalData(globalData)
+{
+}
+
+BytecodeCacheWriter::~BytecodeCacheWriter()
+{
+}
+
+bool BytecodeCacheWriter::addProgram(const String& source, JSParserStrictness strictness, UnlinkedProgramCodeBlock* codeBlock)
+{
+    if (source.isNull())
+        return false;
+
+    BytecodeCacheEncoder encoder(m_globalData, m_data);
+    unsigned offset;
+    if (!encoder.encodeCodeBlock(codeBlock, offset))
+        return false;
+
+    Entry entry;
+    computeSourceDigest(source, entry.sourceDigest);
+    entry.sourceLength = source.length();
+    entry.sourceStringHash = source.impl()->hash();
+    entry.strictness = strictness;
+    entry.offset = offset;
+    entry.size = m_data.size() - offset;
+    m_entries.append(entry);
+    return true;
+}
+
+// Writes to a file next to path and renames it over path only once it is
+// complete. Another process may have the old file mapped; truncating it in
+// place would pull the pages from under that mapping.
+bool BytecodeCacheWriter::writeToFile(const char* path)
+{
+#if OS(UNIX)
+    CString temporaryPath = String::format("%s.%d.tmp", path, static_cast<int>(getpid())).utf8();
+#else
+    CString temporaryPath = String::format("%s.tmp", path).utf8();
+#endif
+    FILE* file = fopen(temporaryPath.data(), "wb");
+    if (!file)
+        return false;
+
+    uint32_t header[5] = { formatVersion, bytecodeFingerprint(), m_entries.size(), headerSize + m_entries.size() * entrySize, m_data.size() };
+    bool succeeded = fwrite(magic, sizeof(magic), 1, file) == 1 && fwrite(header, sizeof(header), 1, file) == 1;
+    for (size_t i = 0; i < m_entries.size() && succeeded; ++i) {
+        const Entry& entry = m_entries[i];
+        uint32_t fields[6] = { entry.sourceLength, entry.sourceStringHash, entry.strictness, entry.offset, entry.size, checksum(m_data.data() + entry.offset, entry.size) };
+        succeeded = fwrite(entry.sourceDigest, sourceDigestSize, 1, file) == 1 && fwrite(fields, sizeof(fields), 1, file) == 1;
+    }
+    if (succeeded && m_data.size())
+        succeeded = fwrite(m_data.data(), m_data.size(), 1, file) == 1;
+    if (fclose(file))
+        succeeded = false;
+#if !OS(UNIX)
+    // Without mappings nothing holds the old file, but rename() will not replace it.
+    if (succeeded)
+        remove(path);
+#endif
+    if (succeeded)
+        succeeded = !rename(temporaryPath.data(), path);
+    if (!succeeded)
+        remove(temporaryPath.data());
+    return succeeded;
+}
+
+} // namespace JSC
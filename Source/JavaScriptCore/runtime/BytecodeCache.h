@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BytecodeCache_h
+#define BytecodeCache_h
+
+#include "ParserModes.h"
+#include <wtf/PassRefPtr.h>
+#include <wtf/RefCounted.h>
+#include <wtf/Vector.h>
+#include <wtf/text/WTFString.h>
+
+namespace JSC {
+
+class JSGlobalData;
+class SourceCode;
+class UnlinkedFunctionCodeBlock;
+class UnlinkedProgramCodeBlock;
+
+// A file of unlinked program code, so that a process can skip parsing and
+// bytecode generation for the scripts that an earlier one ran. The layout,
+// in the byte order of the host, is:
+//
+//     "JSCBCODE" uint32 version, uint32 fingerprint of the bytecode format,
+//     uint32 entry count, uint32 data offset, uint32 data size
+//     entry count times: 20 byte SHA-1 digest of the UTF-8 source, uint32
+//     source length, uint32 StringImpl hash of the source, uint32 strictness,
+//     uint32 offset, uint32 size, uint32 checksum
+//     the data: code block records, each program first, then the bodies of
+//     the functions in it.
+//
+// Offsets are relative to the data. An entry's checksum covers its data, and
+// is checked the first time the entry is used. Function bodies are decoded
+// the first time they are called.
+static const size_t sourceDigestSize = 20;
+
+class BytecodeCacheFile : public RefCounted<BytecodeCacheFile> {
+public:
+    static PassRefPtr<BytecodeCacheFile> open(const char* path);
+    ~BytecodeCacheFile();
+
+    UnlinkedProgramCodeBlock* programCodeBlock(JSGlobalData&, const SourceCode&, JSParserStrictness);
+    UnlinkedFunctionCodeBlock* functionCodeBlock(JSGlobalData&, unsigned offset);
+
+private:
+    struct Entry {
+        uint8_t sourceDigest[sourceDigestSize];
+        unsigned sourceLength;
+        unsigned sourceStringHash;
+        unsigned strictness;
+        unsigned offset;
+        unsigned size;
+        unsigned checksum;
+        bool isVerified;
+    };
+
+    BytecodeCacheFile(const uint8_t*, size_t, bool isMapped);
+    bool readEntries();
+
+    const uint8_t* m_data;
+    size_t m_size;
+    bool m_isMapped;
+    const uint8_t* m_codeBlocks;
+    size_t m_codeBlocksSize;
+    Vector<Entry> m_entries;
+};
+
+class BytecodeCacheWriter {
+public:
+    BytecodeCacheWriter(JSGlobalData&);
+    ~BytecodeCacheWriter();
+
+    // Returns false if the code cannot be cached, for instance because it
+    // was compiled for the debugger.
+    bool addProgram(const String& source, JSParserStrictness, UnlinkedProgramCodeBlock*);
+    bool writeToFile(const char* path);
+
+private:
+    struct Entry {
+        uint8_t sourceDigest[sourceDigestSize];
+        unsigned sourceLength;
+        unsigned sourceStringHash;
+        unsigned strictness;
+        unsigned offset;
+        unsigned size;
+    };
+
+    JSGlobalData& m_globalData;
+    Vector<uint8_t> m_data;
+    Vector<Entry> m_entries;
+};
+
+} // namespace JSC
+
+#endif // BytecodeCache_h
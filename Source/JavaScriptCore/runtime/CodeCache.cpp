@@ -27,6 +27,7 @@
 
 #include "CodeCache.h"
 
+#include "BytecodeCache.h"
 #include "BytecodeGenerator.h"
 #include "CodeSpecializationKind.h"
 #include "Parser.h"
@@ -43,6 +44,22 @@ CodeCache::~CodeCache()
 {
 }
 
+struct WriteProgramCodeBlock {
+    WriteProgramCodeBlock(BytecodeCacheWriter& writer)
+        : m_writer(writer)
+    {
+    }
+
+    void operator()(const CodeCache::CodeBlockKey& key, const Strong<UnlinkedCodeBlock>& codeBlock)
+    {
+        if ((key.second >> 1) != CodeCache::ProgramType)
+            return;
+        m_writer.addProgram(key.first, static_cast<JSParserStrictness>(key.second & 1), jsCast<UnlinkedProgramCodeBlock*>(codeBlock.get()));
+    }
+
+    BytecodeCacheWriter& m_writer;
+};
+
 CodeCache::CodeBlockKey CodeCache::makeCodeBlockKey(const SourceCode& source, CodeCache::CodeType type, JSParserStrictness strictness)
 {
     return std::make_pair(source.toString(), (type << 1) | strictness);
@@ -53,11 +70,16 @@ template <typename T> struct CacheTypes { };
 template <> struct CacheTypes<UnlinkedProgramCodeBlock> {
     typedef JSC::ProgramNode RootNode;
     static const CodeCache::CodeType codeType = CodeCache::ProgramType;
+    static UnlinkedProgramCodeBlock* fromBytecodeCache(JSGlobalData& globalData, BytecodeCacheFile* file, const SourceCode& source, JSParserStrictness strictness)
+    {
+        return file ? file->programCodeBlock(globalData, source, strictness) : 0;
+    }
 };
 
 template <> struct CacheTypes<UnlinkedEvalCodeBlock> {
     typedef JSC::EvalNode RootNode;
     static const CodeCache::CodeType codeType = CodeCache::EvalType;
+    static UnlinkedEvalCodeBlock* fromBytecodeCache(JSGlobalData&, BytecodeCacheFile*, const SourceCode&, JSParserStrictness) { return 0; }
 };
 
 template <class UnlinkedCodeBlockType, class ExecutableType>
@@ -73,6 +95,12 @@ UnlinkedCodeBlockType* CodeCache::getCodeBlock(JSGlobalData& globalData, Executa
             executable->recordParse(unlinkedCode->codeFeatures(), unlinkedCode->hasCapturedVariables(), firstLine, firstLine + unlinkedCode->lineCount());
             return unlinkedCode;
         }
+        if (UnlinkedCodeBlockType* unlinkedCode = CacheTypes<UnlinkedCodeBlockType>::fromBytecodeCache(globalData, m_bytecodeCacheFile.get(), source, strictness)) {
+            unsigned firstLine = source.firstLine() + unlinkedCode->firstLine();
+            executable->recordParse(unlinkedCode->codeFeatures(), unlinkedCode->hasCapturedVariables(), firstLine, firstLine + unlinkedCode->lineCount());
+            m_cachedCodeBlocks.add(key, Strong<UnlinkedCodeBlock>(globalData, unlinkedCode));
+            return unlinkedCode;
+        }
         storeInCache = true;
     }
 
@@ -132,6 +160,15 @@ UnlinkedFunctionCodeBlock* CodeCache::generateFunctionCodeBlock(JSGlobalData& gl
 
 UnlinkedFunctionCodeBlock* CodeCache::getFunctionCodeBlock(JSGlobalData& globalData, UnlinkedFunctionExecutable* executable, const SourceCode& source, CodeSpecializationKind kind, DebuggerMode debuggerMode, ProfilerMode profilerMode, ParserError& error)
 {
+    unsigned& bytecodeCacheOffset = kind == CodeForCall ? executable->m_bytecodeCacheOffsetForCall : executable->m_bytecodeCacheOffsetForConstruct;
+    if (executable->m_bytecodeCacheFile && bytecodeCacheOffset && debuggerMode == DebuggerOff && profilerMode == ProfilerOff) {
+        UnlinkedFunctionCodeBlock* result = executable->m_bytecodeCacheFile->functionCodeBlock(globalData, bytecodeCacheOffset);
+        if (result) {
+            m_cachedFunctionCode.add(result, Strong<UnlinkedFunctionCodeBlock>(globalData, result));
+            return result;
+        }
+        bytecodeCacheOffset = 0;
+    }
     return generateFunctionCodeBlock(globalData, executable, source, kind, debuggerMode, profilerMode, error);
 }
 
@@ -176,4 +213,25 @@ void CodeCache::usedFunctionCode(JSGlobalData& globalData, UnlinkedFunctionCodeB
     m_cachedFunctionCode.add(codeBlock, Strong<UnlinkedFunctionCodeBlock>(globalData, codeBlock));
 }
 
+bool CodeCache::loadBytecodeCache(const char* path)
+{
+    m_bytecodeCacheFile = BytecodeCacheFile::open(path);
+    return m_bytecodeCacheFile;
+}
+
+bool CodeCache::writeBytecodeCache(JSGlobalData& globalData, const char* path)
+{
+    BytecodeCacheWriter writer(globalData);
+    WriteProgramCodeBlock functor(writer);
+    m_cachedCodeBlocks.forEach(functor);
+    return writer.writeToFile(path);
+}
+
+void CodeCache::clear()
+{
+    m_cachedCodeBlocks.clear();
+    m_cachedGlobalFunctions.clear();
+    m_cachedFunctionCode.clear();
+}
+
 }
@@ -35,10 +35,12 @@
 #include <wtf/Forward.h>
 #include <wtf/PassOwnPtr.h>
 #include <wtf/RandomNumber.h>
+#include <wtf/RefPtr.h>
 #include <wtf/text/WTFString.h>
 
 namespace JSC {
 
+class BytecodeCacheFile;
 class EvalExecutable;
 class Identifier;
 class ProgramExecutable;
@@ -81,6 +83,21 @@ public:
         m_data[newIndex].second = value;
         ASSERT(m_map.size() <= CacheSize);
     }
+    template<typename Functor> void forEach(Functor& functor)
+    {
+        for (int i = 0; i < CacheSize; ++i) {
+            if (m_data[i].second)
+                functor(m_data[i].first, m_data[i].second);
+        }
+    }
+    void clear()
+    {
+        m_map.clear();
+        for (int i = 0; i < CacheSize; ++i) {
+            m_data[i].first = KeyType();
+            m_data[i].second.clear();
+        }
+    }
 private:
     HashMap<KeyType, unsigned> m_map;
     FixedArray<std::pair<KeyType, EntryType>, CacheSize> m_data;
@@ -96,6 +113,13 @@ public:
     UnlinkedFunctionCodeBlock* getFunctionCodeBlock(JSGlobalData&, UnlinkedFunctionExecutable*, const SourceCode&, CodeSpecializationKind, DebuggerMode, ProfilerMode, ParserError&);
     UnlinkedFunctionExecutable* getFunctionExecutableFromGlobalCode(JSGlobalData&, const Identifier&, const SourceCode&, ParserError&);
     void usedFunctionCode(JSGlobalData&, UnlinkedFunctionCodeBlock*);
+    void clear();
+
+    // Programs that are not in memory are looked up in the loaded file, and
+    // writing saves every program in memory that was not compiled for the
+    // debugger or the profiler.
+    bool loadBytecodeCache(const char* path);
+    bool writeBytecodeCache(JSGlobalData&, const char* path);
     ~CodeCache();
 
     enum CodeType { EvalType, ProgramType, FunctionType };
@@ -120,6 +144,7 @@ private:
     CacheMap<CodeBlockKey, Strong<UnlinkedCodeBlock>, kMaxCodeBlockEntries> m_cachedCodeBlocks;
     CacheMap<GlobalFunctionKey, Strong<UnlinkedFunctionExecutable>, kMaxGlobalFunctionEntries> m_cachedGlobalFunctions;
     CacheMap<UnlinkedFunctionCodeBlock*, Strong<UnlinkedFunctionCodeBlock>, kMaxFunctionCodeBlocks> m_cachedFunctionCode;
+    RefPtr<BytecodeCacheFile> m_bytecodeCacheFile;
 };
 
 }
@@ -684,7 +684,12 @@ CodeBlockHash NativeExecutable::hashFor(CodeSpecializationKind kind) const
 
 CodeBlockHash ScriptExecutable::hashFor(CodeSpecializationKind kind) const
 {
-    return CodeBlockHash(source(), kind);
+    if (!m_hasHashForCall) {
+        m_hashForCall = CodeBlockHash(source(), CodeForCall);
+        m_hasHashForCall = true;
+    }
+    // The hashes of the specializations only differ in their low bits.
+    return CodeBlockHash(m_hashForCall.hash() ^ static_cast<unsigned>(kind));
 }
 
 }
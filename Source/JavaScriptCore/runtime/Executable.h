@@ -344,6 +344,7 @@ namespace JSC {
             : ExecutableBase(globalData, structure, NUM_PARAMETERS_NOT_COMPILED)
             , m_source(source)
             , m_features(isInStrictContext ? StrictModeFeature : 0)
+            , m_hasHashForCall(false)
         {
         }
 
@@ -351,6 +352,7 @@ namespace JSC {
             : ExecutableBase(exec->globalData(), structure, NUM_PARAMETERS_NOT_COMPILED)
             , m_source(source)
             , m_features(isInStrictContext ? StrictModeFeature : 0)
+            , m_hasHashForCall(false)
         {
         }
 
@@ -402,6 +404,10 @@ namespace JSC {
         bool m_hasCapturedVariables;
         int m_firstLine;
         int m_lastLine;
+
+        // Hashing the source is expensive, and the source never changes.
+        mutable bool m_hasHashForCall;
+        mutable CodeBlockHash m_hashForCall;
     };
 
     class EvalExecutable : public ScriptExecutable {
@@ -147,6 +147,11 @@ namespace JSC {
             ASSERT(tryGetKnownInheritorID());
             m_inheritorIDWatchpoint.add(watchpoint);
         }
+        
+        InlineWatchpointSet& inheritorIDWatchpointSet()
+        {
+            return m_inheritorIDWatchpoint;
+        }
 
         static size_t offsetOfCachedInheritorID()
         {
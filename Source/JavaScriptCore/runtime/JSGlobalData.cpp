@@ -449,6 +449,9 @@ struct StackPreservingRecompiler : public MarkedBlock::VoidFunctor {
 void JSGlobalData::releaseExecutableMemory()
 {
     if (dynamicGlobalObject) {
+#if ENABLE(GGC)
+        heap.abortIncrementalMarking();
+#endif
         StackPreservingRecompiler recompiler;
         HashSet<JSCell*> roots;
         heap.getConservativeRegisterRoots(roots);
@@ -477,6 +480,14 @@ void JSGlobalData::releaseExecutableMemory()
     heap.collectAllGarbage();
 }
     
+void JSGlobalData::releaseMemoryUnderPressure()
+{
+    m_codeCache->clear();
+    heap.deleteAllCompiledCode();
+    releaseExecutableMemory();
+    heap.releaseFreeBlocks();
+}
+
 void releaseExecutableMemory(JSGlobalData& globalData)
 {
     globalData.releaseExecutableMemory();
@@ -43,6 +43,7 @@
 #include "SmallStrings.h"
 #include "Strong.h"
 #include "Terminator.h"
+#include "TierUpStatistics.h"
 #include "TimeoutChecker.h"
 #include "TypedArrayDescriptor.h"
 #include "WeakRandom.h"
@@ -298,6 +299,7 @@ namespace JSC {
         NativeExecutable* getHostFunction(NativeFunction, NativeFunction constructor);
 
         TimeoutChecker timeoutChecker;
+        TierUpStatistics tierUpStatistics;
         Terminator terminator;
 
         JSValue exception;
@@ -379,6 +381,9 @@ namespace JSC {
 
         bool isCollectorBusy() { return heap.isBusy(); }
         JS_EXPORT_PRIVATE void releaseExecutableMemory();
+        // Releases everything that can be regenerated, and gives the memory
+        // the heap keeps for reuse back to the system.
+        JS_EXPORT_PRIVATE void releaseMemoryUnderPressure();
 
 #if ENABLE(GC_VALIDATION)
         bool isInitializingObject() const; 
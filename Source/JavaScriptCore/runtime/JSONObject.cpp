@@ -105,8 +105,6 @@ private:
 
     friend class Holder;
 
-    static void appendQuotedString(StringBuilder&, const String&);
-
     JSValue toJSON(JSValue, const PropertyNameForFunctionCall&);
 
     enum StringifyResult { StringifyFailed, StringifySucceeded, StringifyFailedDueToUndefinedValue };
@@ -301,7 +299,7 @@ static void appendStringToStringBuilder(StringBuilder& builder, const CharType*
     }
 }
     
-void Stringifier::appendQuotedString(StringBuilder& builder, const String& value)
+void appendQuotedJSONString(StringBuilder& builder, const String& value)
 {
     int length = value.length();
 
@@ -379,7 +377,7 @@ Stringifier::StringifyResult Stringifier::appendStringifiedValue(StringBuilder&
 
     String stringValue;
     if (value.getString(m_exec, stringValue)) {
-        appendQuotedString(builder, stringValue);
+        appendQuotedJSONString(builder, stringValue);
         return StringifySucceeded;
     }
 
@@ -556,7 +554,7 @@ bool Stringifier::Holder::appendNextProperty(Stringifier& stringifier, StringBui
         stringifier.startNewLine(builder);
 
         // Append the property name.
-        appendQuotedString(builder, propertyName.string());
+        appendQuotedJSONString(builder, propertyName.string());
         builder.append(':');
         if (stringifier.willIndent())
             builder.append(' ');
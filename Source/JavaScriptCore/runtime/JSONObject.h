@@ -27,6 +27,7 @@
 #define JSONObject_h
 
 #include "JSObject.h"
+#include <wtf/text/StringBuilder.h>
 
 namespace JSC {
 
@@ -62,6 +63,7 @@ namespace JSC {
     };
 
     String JSONStringify(ExecState*, JSValue, unsigned indent);
+    void appendQuotedJSONString(StringBuilder&, const String&);
 
 } // namespace JSC
 
@@ -122,6 +122,14 @@ namespace JSC {
     v(unsigned, opaqueRootMergeThreshold, 1000) \
     v(double, minHeapUtilization, 0.8) \
     v(double, minCopiedBlockUtilization, 0.9) \
+    v(unsigned, maxEvacuatedBytesPerCollection, 0) \
+    v(bool, useBackgroundSweeping, true) \
+    /* Off until GC stress tests cover deep mixed-tier call stacks. */ \
+    v(bool, usePreciseJSStackScanning, false) \
+    v(bool, useGenerationalGC, true) \
+    v(bool, useIncrementalMarking, true) \
+    v(double, incrementalMarkingHeapGrowth, 2) \
+    v(unsigned, incrementalMarkingSliceSize, 1000) \
     \
     v(bool, forceWeakRandomSeed, false) \
     v(unsigned, forcedWeakRandomSeed, 0) \
@@ -129,9 +137,13 @@ namespace JSC {
     v(bool, useZombieMode, false) \
     v(bool, objectsAreImmortal, false) \
     v(bool, showObjectStatistics, false) \
+    v(bool, sampleAllocationSites, false) \
+    v(unsigned, allocationSiteSampleInterval, 256 * 1024) \
     \
     v(unsigned, gcMaxHeapSize, 0) \
     v(bool, recordGCPauseTimes, false) \
+    v(bool, recordTierUpStatistics, false) \
+    v(unsigned, maximumTierUpStatisticsRecords, 10000) \
     v(bool, logHeapStatisticsAtExit, false) 
 
 class Options {
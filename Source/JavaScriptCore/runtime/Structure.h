@@ -349,6 +349,11 @@ namespace JSC {
             m_transitionWatchpointSet.add(watchpoint);
         }
         
+        InlineWatchpointSet& transitionWatchpointSet() const
+        {
+            return m_transitionWatchpointSet;
+        }
+        
         void notifyTransitionFromThisStructure() const
         {
             m_transitionWatchpointSet.notifyWrite();
@@ -556,6 +561,8 @@ namespace JSC {
 #if ENABLE(GC_VALIDATION)
         validate(cell);
 #endif
+        if (UNLIKELY(!!m_snapshotBuilder))
+            recordSnapshotEdge(cell);
         if (Heap::testAndSetMarked(cell) || !cell->structure())
             return;
 
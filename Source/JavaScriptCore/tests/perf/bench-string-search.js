@@ -0,0 +1,24 @@
+(function () {
+    var lines = [];
+    for (var i = 0; i < 50000; ++i)
+        lines.push("2012-11-20 12:00:00 INFO [worker " + (i % 16) + "] request " + i + " served in " + (i % 97) + "ms");
+    var log8 = lines.join("\n");
+    var log16 = log8 + "\u2026";
+
+    var logs = [log8, log16];
+    for (var i = 0; i < 20; ++i) {
+        for (var j = 0; j < logs.length; ++j) {
+            var log = logs[j];
+            if (log.indexOf("ERROR") != -1)
+                throw "Found a missing string";
+            if (log.indexOf("request 49999 ") == -1)
+                throw "Missed a string";
+            if (log.lastIndexOf("#") != -1)
+                throw "Found a missing character";
+            if (log.split("\n").length != 50000)
+                throw "Bad split";
+            if (log.replace("served in 96ms", "served slowly") == log)
+                throw "Bad replace";
+        }
+    }
+})();
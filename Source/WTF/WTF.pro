@@ -163,6 +163,7 @@ HEADERS += \
     text/StringHash.h \
     text/StringImpl.h \
     text/StringOperators.h \
+    text/StringSearchFastPath.h \
     text/TextPosition.h \
     text/WTFString.h \
     Threading.h \
@@ -994,6 +994,45 @@ ALWAYS_INLINE static size_t findInner(const SearchCharacterType* searchCharacter
     return index + i;        
 }
 
+#if USE(VECTORIZED_STRING_SEARCH)
+// When both strings have the same width, look for the first and the last
+// characters of the match a block at a time, and only compare the rest of the
+// match where both are found. Assumes that matchLength is at least 2.
+template <typename CharacterType>
+ALWAYS_INLINE static size_t findInner(const CharacterType* searchCharacters, const CharacterType* matchCharacters, unsigned index, unsigned searchLength, unsigned matchLength)
+{
+    typedef CharacterBlockMatcher<CharacterType> Matcher;
+
+    // delta is the number of additional times to test; delta == 0 means test only once.
+    unsigned delta = searchLength - matchLength;
+    unsigned lastOffset = matchLength - 1;
+    CharacterType firstCharacter = matchCharacters[0];
+    CharacterType lastCharacter = matchCharacters[lastOffset];
+
+    unsigned i = 0;
+    if (delta >= Matcher::blockLength) {
+        Matcher firstMatcher(firstCharacter);
+        Matcher lastMatcher(lastCharacter);
+        for (; delta - i >= Matcher::blockLength; i += Matcher::blockLength) {
+            if (!firstMatcher.matches(searchCharacters + i, lastMatcher, searchCharacters + i + lastOffset))
+                continue;
+            for (unsigned j = i; j < i + Matcher::blockLength; ++j) {
+                if (searchCharacters[j] == firstCharacter && searchCharacters[j + lastOffset] == lastCharacter
+                    && equal(searchCharacters + j + 1, matchCharacters + 1, matchLength - 2))
+                    return index + j;
+            }
+        }
+    }
+
+    for (; i <= delta; ++i) {
+        if (searchCharacters[i] == firstCharacter && searchCharacters[i + lastOffset] == lastCharacter
+            && equal(searchCharacters + i + 1, matchCharacters + 1, matchLength - 2))
+            return index + i;
+    }
+    return notFound;
+}
+#endif
+
 size_t StringImpl::find(StringImpl* matchString)
 {
     // Check for null string to match against
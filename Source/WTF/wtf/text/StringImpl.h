@@ -29,6 +29,7 @@
 #include <wtf/StdLibExtras.h>
 #include <wtf/StringHasher.h>
 #include <wtf/Vector.h>
+#include <wtf/text/StringSearchFastPath.h>
 #include <wtf/unicode/Unicode.h>
 
 #if PLATFORM(QT)
@@ -967,12 +968,7 @@ WTF_EXPORT_STRING_API bool equalIgnoringNullity(StringImpl*, StringImpl*);
 template<typename CharacterType>
 inline size_t find(const CharacterType* characters, unsigned length, CharacterType matchCharacter, unsigned index = 0)
 {
-    while (index < length) {
-        if (characters[index] == matchCharacter)
-            return index;
-        ++index;
-    }
-    return notFound;
+    return findCharacter(characters, length, matchCharacter, index);
 }
 
 ALWAYS_INLINE size_t find(const UChar* characters, unsigned length, LChar matchCharacter, unsigned index = 0)
@@ -1014,11 +1010,7 @@ inline size_t reverseFind(const CharacterType* characters, unsigned length, Char
         return notFound;
     if (index >= length)
         index = length - 1;
-    while (characters[index] != matchCharacter) {
-        if (!index--)
-            return notFound;
-    }
-    return index;
+    return reverseFindCharacter(characters, matchCharacter, index);
 }
 
 ALWAYS_INLINE size_t reverseFind(const UChar* characters, unsigned length, LChar matchCharacter, unsigned index = UINT_MAX)
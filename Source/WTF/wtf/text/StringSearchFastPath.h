@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef StringSearchFastPath_h
+#define StringSearchFastPath_h
+
+#include <stddef.h>
+#include <wtf/NotFound.h>
+#include <wtf/Platform.h>
+#include <wtf/unicode/Unicode.h>
+
+#if CPU(X86_64) || (CPU(X86) && defined(__SSE2__))
+#include <emmintrin.h>
+#define WTF_USE_SSE2_STRING_SEARCH 1
+#elif HAVE(ARM_NEON_INTRINSICS) && !(PLATFORM(BIG_ENDIAN) || PLATFORM(MIDDLE_ENDIAN))
+#include <arm_neon.h>
+#define WTF_USE_NEON_STRING_SEARCH 1
+#endif
+
+#if USE(SSE2_STRING_SEARCH) || USE(NEON_STRING_SEARCH)
+#define WTF_USE_VECTORIZED_STRING_SEARCH 1
+#endif
+
+namespace WTF {
+
+#if USE(VECTORIZED_STRING_SEARCH)
+
+// Compares 16 bytes worth of characters at a time against one character. The
+// vector registers only tell whether there is a match in a block; the caller
+// then finds it character by character, which is cheap since it only happens
+// once per match.
+template<typename CharacterType> class CharacterBlockMatcher;
+
+template<> class CharacterBlockMatcher<LChar> {
+public:
+    static const unsigned blockLength = 16;
+
+    explicit CharacterBlockMatcher(LChar character)
+#if USE(SSE2_STRING_SEARCH)
+        : m_pattern(_mm_set1_epi8(static_cast<char>(character)))
+#else
+        : m_pattern(vdupq_n_u8(character))
+#endif
+    {
+    }
+
+    // Tells if any of the blockLength characters at block is the character.
+    bool matches(const LChar* block) const
+    {
+#if USE(SSE2_STRING_SEARCH)
+        return !!_mm_movemask_epi8(compare(block));
+#else
+        return any(compare(block));
+#endif
+    }
+
+    // Tells if, for some i < blockLength, block[i] is this character and
+    // otherBlock[i] is the other matcher's.
+    bool matches(const LChar* block, const CharacterBlockMatcher& other, const LChar* otherBlock) const
+    {
+#if USE(SSE2_STRING_SEARCH)
+        return !!_mm_movemask_epi8(_mm_and_si128(compare(block), other.compare(otherBlock)));
+#else
+        return any(vandq_u8(compare(block), other.compare(otherBlock)));
+#endif
+    }
+
+private:
+#if USE(SSE2_STRING_SEARCH)
+    __m128i compare(const LChar* block) const
+    {
+        return _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block)), m_pattern);
+    }
+
+    __m128i m_pattern;
+#else
+    uint8x16_t compare(const LChar* block) const
+    {
+        return vceqq_u8(vld1q_u8(block), m_pattern);
+    }
+
+    static bool any(uint8x16_t mask)
+    {
+        uint64x2_t words = vreinterpretq_u64_u8(mask);
+        return !!(vgetq_lane_u64(words, 0) | vgetq_lane_u64(words, 1));
+    }
+
+    uint8x16_t m_pattern;
+#endif
+};
+
+template<> class CharacterBlockMatcher<UChar> {
+public:
+    static const unsigned blockLength = 8;
+
+    explicit CharacterBlockMatcher(UChar character)
+#if USE(SSE2_STRING_SEARCH)
+        : m_pattern(_mm_set1_epi16(static_cast<short>(character)))
+#else
+        : m_pattern(vdupq_n_u16(character))
+#endif
+    {
+    }
+
+    bool matches(const UChar* block) const
+    {
+#if USE(SSE2_STRING_SEARCH)
+        return !!_mm_movemask_epi8(compare(block));
+#else
+        return any(compare(block));
+#endif
+    }
+
+    bool matches(const UChar* block, const CharacterBlockMatcher& other, const UChar* otherBlock) const
+    {
+#if USE(SSE2_STRING_SEARCH)
+        return !!_mm_movemask_epi8(_mm_and_si128(compare(block), other.compare(otherBlock)));
+#else
+        return any(vandq_u16(compare(block), other.compare(otherBlock)));
+#endif
+    }
+
+private:
+#if USE(SSE2_STRING_SEARCH)
+    __m128i compare(const UChar* block) const
+    {
+        return _mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block)), m_pattern);
+    }
+
+    __m128i m_pattern;
+#else
+    uint16x8_t compare(const UChar* block) const
+    {
+        return vceqq_u16(vld1q_u16(reinterpret_cast<const uint16_t*>(block)), m_pattern);
+    }
+
+    static bool any(uint16x8_t mask)
+    {
+        uint64x2_t words = vreinterpretq_u64_u16(mask);
+        return !!(vgetq_lane_u64(words, 0) | vgetq_lane_u64(words, 1));
+    }
+
+    uint16x8_t m_pattern;
+#endif
+};
+
+#endif // USE(VECTORIZED_STRING_SEARCH)
+
+template<typename CharacterType>
+inline size_t findCharacter(const CharacterType* characters, unsigned length, CharacterType matchCharacter, unsigned index)
+{
+#if USE(VECTORIZED_STRING_SEARCH)
+    typedef CharacterBlockMatcher<CharacterType> Matcher;
+    // Short scans are not worth setting up the vector registers for.
+    if (index < length && length - index >= 2 * Matcher::blockLength) {
+        Matcher matcher(matchCharacter);
+        do {
+            if (matcher.matches(characters + index)) {
+                while (characters[index] != matchCharacter)
+                    ++index;
+                return index;
+            }
+            index += Matcher::blockLength;
+        } while (length - index >= Matcher::blockLength);
+    }
+#endif
+    while (index < length) {
+        if (characters[index] == matchCharacter)
+            return index;
+        ++index;
+    }
+    return notFound;
+}
+
+// Searches backwards from index, inclusive. The caller makes sure that index
+// is within the characters.
+template<typename CharacterType>
+inline size_t reverseFindCharacter(const CharacterType* characters, CharacterType matchCharacter, unsigned index)
+{
+#if USE(VECTORIZED_STRING_SEARCH)
+    typedef CharacterBlockMatcher<CharacterType> Matcher;
+    if (index >= 2 * Matcher::blockLength) {
+        Matcher matcher(matchCharacter);
+        do {
+            unsigned blockStart = index + 1 - Matcher::blockLength;
+            if (matcher.matches(characters + blockStart)) {
+                while (characters[index] != matchCharacter)
+                    --index;
+                return index;
+            }
+            if (!blockStart)
+                return notFound;
+            index = blockStart - 1;
+        } while (index + 1 >= Matcher::blockLength);
+    }
+#endif
+    while (characters[index] != matchCharacter) {
+        if (!index--)
+            return notFound;
+    }
+    return index;
+}
+
+} // namespace WTF
+
+#endif // StringSearchFastPath_h
@@ -108,4 +108,10 @@ void GCController::discardAllCompiledCode()
     JSDOMWindow::commonJSGlobalData()->heap.deleteAllCompiledCode();
 }
 
+void GCController::releaseMemoryUnderPressure()
+{
+    JSLockHolder lock(JSDOMWindow::commonJSGlobalData());
+    JSDOMWindow::commonJSGlobalData()->releaseMemoryUnderPressure();
+}
+
 } // namespace WebCore
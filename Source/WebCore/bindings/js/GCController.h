@@ -46,6 +46,7 @@ namespace WebCore {
         void garbageCollectOnAlternateThreadForDebugging(bool waitUntilDone); // Used for stress testing.
         void setJavaScriptGarbageCollectorTimerEnabled(bool);
         void discardAllCompiledCode();
+        void releaseMemoryUnderPressure();
 
     private:
         GCController(); // Use gcController() instead
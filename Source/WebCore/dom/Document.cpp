@@ -545,6 +545,7 @@ Document::Document(Frame* frame, const KURL& url, bool isXHTML, bool isHTML)
     m_listenerTypes = 0;
     m_inStyleRecalc = false;
     m_closeAfterStyleRecalc = false;
+    m_totalStyleRecalcTime = 0;
 
     m_gotoAnchorNeededAfterStylesheetsLoad = false;
 
@@ -1806,6 +1807,7 @@ void Document::recalcStyle(StyleChange change)
         m_styleSheetCollection->updateActiveStyleSheets(DocumentStyleSheetCollection::FullUpdate);
 
     InspectorInstrumentationCookie cookie = InspectorInstrumentation::willRecalculateStyle(this);
+    double styleRecalcStartTime = monotonicallyIncreasingTime();
 
     if (m_elemSheet && m_elemSheet->contents()->usesRemUnits())
         m_styleSheetCollection->setUsesRemUnit(true);
@@ -1876,6 +1878,7 @@ void Document::recalcStyle(StyleChange change)
         implicitClose();
     }
 
+    m_totalStyleRecalcTime += monotonicallyIncreasingTime() - styleRecalcStartTime;
     InspectorInstrumentation::didRecalculateStyle(cookie);
 }
 
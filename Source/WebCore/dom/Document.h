@@ -1161,6 +1161,8 @@ public:
     void notifySeamlessChildDocumentsOfStylesheetUpdate() const;
 
     bool inStyleRecalc() { return m_inStyleRecalc; }
+    // Seconds spent in recalcStyle() over the lifetime of the document.
+    double totalStyleRecalcTime() const { return m_totalStyleRecalcTime; }
 
     // Return a Locale for the default locale if the argument is null or empty.
     Locale& getCachedLocale(const AtomicString& locale = nullAtom);
@@ -1346,6 +1348,7 @@ private:
     bool m_pendingStyleRecalcShouldForce;
     bool m_inStyleRecalc;
     bool m_closeAfterStyleRecalc;
+    double m_totalStyleRecalcTime;
 
     bool m_gotoAnchorNeededAfterStylesheetsLoad;
     bool m_isDNSPrefetchEnabled;
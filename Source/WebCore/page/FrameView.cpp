@@ -192,6 +192,8 @@ FrameView::FrameView(Frame* frame)
     , m_shouldAutoSize(false)
     , m_inAutoSize(false)
     , m_didRunAutosize(false)
+    , m_totalLayoutTime(0)
+    , m_totalPaintTime(0)
 #if ENABLE(CSS_FILTERS)
     , m_hasSoftwareFilters(false)
 #endif
@@ -1040,6 +1042,7 @@ void FrameView::layout(bool allowSubtree)
         return;
 
     InspectorInstrumentationCookie cookie = InspectorInstrumentation::willLayout(m_frame.get());
+    double layoutStartTime = monotonicallyIncreasingTime();
 
     if (!allowSubtree && m_layoutRoot) {
         m_layoutRoot->markContainingBlocksForLayout(false);
@@ -1273,6 +1276,9 @@ void FrameView::layout(bool allowSubtree)
 
     InspectorInstrumentation::didLayout(cookie, root);
 
+    if (m_nestedLayoutCount == 1)
+        m_totalLayoutTime += monotonicallyIncreasingTime() - layoutStartTime;
+
     m_nestedLayoutCount--;
     if (m_nestedLayoutCount)
         return;
@@ -3268,8 +3274,10 @@ void FrameView::paintContents(GraphicsContext* p, const IntRect& rect)
         updateAnnotatedRegions();
 #endif
 
-    if (isTopLevelPainter)
+    if (isTopLevelPainter) {
+        m_totalPaintTime += currentTime() - sCurrentPaintTimeStamp;
         sCurrentPaintTimeStamp = 0;
+    }
 
     InspectorInstrumentation::didPaint(cookie, p, rect);
 }
@@ -109,6 +109,10 @@ public:
     void clearLayoutRoot() { m_layoutRoot = 0; }
     int layoutCount() const { return m_layoutCount; }
 
+    // Seconds spent in top-level layouts and paints over the lifetime of the view.
+    double totalLayoutTime() const { return m_totalLayoutTime; }
+    double totalPaintTime() const { return m_totalPaintTime; }
+
     bool needsLayout() const;
     void setNeedsLayout();
 
@@ -527,6 +531,8 @@ private:
     Timer<FrameView> m_deferredRepaintTimer;
     double m_deferredRepaintDelay;
     double m_lastPaintTime;
+    double m_totalLayoutTime;
+    double m_totalPaintTime;
 
     unsigned m_disableRepaints;
 
@@ -26,6 +26,11 @@
 #include "config.h"
 #include "MemoryPressureHandler.h"
 
+#include "FontCache.h"
+#include "GCController.h"
+#include "MemoryCache.h"
+#include "PageCache.h"
+#include <wtf/FastMalloc.h>
 #include <wtf/StdLibExtras.h>
 
 namespace WebCore {
@@ -51,5 +56,28 @@ void MemoryPressureHandler::holdOff(unsigned) { }
 
 void MemoryPressureHandler::respondToMemoryPressure() { }
 #endif
+
+#if !PLATFORM(MAC)
+// Ports without a memory pressure notification call this when they learn of
+// the pressure on their own.
+void MemoryPressureHandler::releaseMemory(bool critical)
+{
+    int savedPageCacheCapacity = pageCache()->capacity();
+    pageCache()->setCapacity(critical ? 0 : pageCache()->pageCount() / 2);
+    pageCache()->setCapacity(savedPageCacheCapacity);
+    pageCache()->releaseAutoreleasedPagesNow();
+
+    fontCache()->purgeInactiveFontData();
+
+    memoryCache()->pruneToPercentage(critical ? 0 : 0.5f);
+
+    if (critical)
+        gcController().releaseMemoryUnderPressure();
+    else
+        gcController().discardAllCompiledCode();
+
+    WTF::releaseFastMallocFreeMemory();
+}
+#endif
  
 } // namespace WebCore
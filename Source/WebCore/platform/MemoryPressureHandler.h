@@ -41,12 +41,15 @@ public:
 
     void holdOff(unsigned);
 
+    // A critical release also collects all the JavaScript garbage and gives
+    // the emptied heap blocks back to the system.
+    void releaseMemory(bool critical);
+
 private:
     MemoryPressureHandler();
     ~MemoryPressureHandler();
 
     void respondToMemoryPressure();
-    void releaseMemory(bool critical);
 
     bool m_installed;
     time_t m_lastRespondTime;
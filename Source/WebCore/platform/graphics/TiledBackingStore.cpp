@@ -54,6 +54,14 @@ TiledBackingStore::~TiledBackingStore()
 {
 }
 
+void TiledBackingStore::setBackend(PassOwnPtr<TiledBackingStoreBackend> backend)
+{
+    // Tiles are created by the backend, so the existing ones have to go.
+    m_backend = backend;
+    m_tiles.clear();
+    startBackingStoreUpdateTimer();
+}
+
 void TiledBackingStore::setTileSize(const IntSize& size)
 {
     m_tileSize = size;
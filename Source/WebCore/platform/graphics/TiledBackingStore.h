@@ -46,6 +46,8 @@ public:
 
     TiledBackingStoreClient* client() { return m_client; }
 
+    void setBackend(PassOwnPtr<TiledBackingStoreBackend>);
+
     void coverWithTilesIfNeeded(const FloatPoint& panningTrajectoryVector = FloatPoint());
 
     float contentsScale() { return m_contentsScale; }
@@ -75,6 +77,8 @@ public:
     IntRect coverRect() const { return m_coverRect; }
     bool visibleAreaIsCovered() const;
     void removeAllNonVisibleTiles();
+    // Drops a single tile, e.g. to reclaim memory; it is created again when needed.
+    void removeTile(const Tile::Coordinate&);
 
     void setSupportsAlpha(bool);
     bool supportsAlpha() const { return m_supportsAlpha; }
@@ -100,7 +104,6 @@ private:
 
     PassRefPtr<Tile> tileAt(const Tile::Coordinate&) const;
     void setTile(const Tile::Coordinate& coordinate, PassRefPtr<Tile> tile);
-    void removeTile(const Tile::Coordinate& coordinate);
 
     IntRect visibleRect() const;
 
@@ -151,7 +151,10 @@ void MemoryPressureHandler::releaseMemory(bool critical)
 
     LayerPool::sharedPool()->drain();
 
-    gcController().discardAllCompiledCode();
+    if (critical)
+        gcController().releaseMemoryUnderPressure();
+    else
+        gcController().discardAllCompiledCode();
 
     WTF::releaseFastMallocFreeMemory();
 }
@@ -93,6 +93,13 @@ public:
 
     virtual QRectF graphicsItemVisibleRect() const { return QRectF(); }
 
+#if USE(TILED_BACKING_STORE)
+    // Clients that scroll the tiles ahead of the frame return the contents
+    // rect they are showing, so that tiles are created around it; an empty
+    // rect means the frame's own scroll position is used.
+    virtual QRect tiledBackingStoreVisibleRect() const { return QRect(); }
+#endif
+
     virtual bool viewResizesToContentsEnabled() const = 0;
 
     virtual QRectF windowRect() const = 0;
@@ -101,6 +108,16 @@ public:
 
     virtual QWindow* ownerWindow() const;
 
+#if USE(ACCELERATED_COMPOSITING)
+    // Clients returning true composite the layer tree on their own, on top
+    // of the frame contents, instead of having it painted into them; they
+    // get didSyncCompositedLayers() rather than repaintViewport() each time
+    // the layers change, and didDetachCompositedLayers() when they go away.
+    virtual bool compositesLayersSeparately() const { return false; }
+    virtual void didSyncCompositedLayers() { }
+    virtual void didDetachCompositedLayers() { }
+#endif
+
 protected:
 #ifndef QT_NO_CURSOR
     virtual QCursor cursor() const = 0;
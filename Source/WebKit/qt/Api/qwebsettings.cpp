@@ -35,8 +35,10 @@
 #endif
 #include "InitWebCoreQt.h"
 #include "IntSize.h"
+#include "JSDOMWindowBase.h"
 #include "KURL.h"
 #include "MemoryCache.h"
+#include "MemoryPressureHandler.h"
 #include "NetworkStateNotifier.h"
 #include "Page.h"
 #include "PageCache.h"
@@ -51,6 +53,8 @@
 #include <QSharedData>
 #include <QStandardPaths>
 #include <QUrl>
+#include <heap/GCPauseStatistics.h>
+#include <runtime/JSLock.h>
 #include <wtf/text/WTFString.h>
 
 
@@ -809,6 +813,7 @@ QPixmap QWebSettings::webGraphic(WebGraphic type)
     as page, object and font cache.
 
     \since 4.6
+    \sa releaseMemoryUnderPressure()
  */
 void QWebSettings::clearMemoryCaches()
 {
@@ -834,6 +839,113 @@ void QWebSettings::clearMemoryCaches()
     WebCore::CrossOriginPreflightResultCache::shared().empty();
 }
 
+/*!
+    Clears the memory caches like clearMemoryCaches() does, then collects
+    the JavaScript garbage and discards all compiled JavaScript code. Call
+    it when the system runs low on memory.
+
+    This is much more expensive than clearMemoryCaches(): the collection
+    stops the pages for its duration, and the JavaScript of the pages runs
+    slower until it has been compiled again.
+
+    \sa clearMemoryCaches()
+*/
+void QWebSettings::releaseMemoryUnderPressure()
+{
+    clearMemoryCaches();
+    WebCore::memoryPressureHandler().releaseMemory(true);
+}
+
+/*!
+    Returns the times spent collecting the garbage of the JavaScript heap
+    shared by the pages of the main thread.
+
+    The map has an entry for each phase of garbage collection: rootMarking,
+    conservativeScan, parallelMarking, weakHarvesting, copying, sweeping, and
+    collection for whole pauses. Each entry is a map holding the number of
+    times the phase ran, as count, and the total, maximum, median, p90 and p99
+    times in milliseconds. The percentiles are rounded up to a power of two
+    microseconds.
+
+    \sa resetGarbageCollectionStatistics()
+*/
+QVariantMap QWebSettings::garbageCollectionStatistics()
+{
+    WebCore::initializeWebCoreQt();
+    JSC::JSGlobalData* globalData = WebCore::JSDOMWindowBase::commonJSGlobalData();
+    JSC::JSLockHolder lock(globalData);
+
+    QVariantMap statistics;
+    const JSC::GCPauseStatistics& pauseStatistics = globalData->heap.pauseStatistics();
+    for (unsigned i = 0; i < JSC::GCPauseStatistics::NumberOfPhases; ++i) {
+        JSC::GCPauseStatistics::Phase phase = static_cast<JSC::GCPauseStatistics::Phase>(i);
+        const JSC::GCPauseHistogram& histogram = pauseStatistics.histogram(phase);
+        QVariantMap times;
+        times.insert(QLatin1String("count"), static_cast<qulonglong>(histogram.count()));
+        times.insert(QLatin1String("total"), histogram.total() * 1000);
+        times.insert(QLatin1String("maximum"), histogram.maximum() * 1000);
+        times.insert(QLatin1String("median"), histogram.percentile(0.5) * 1000);
+        times.insert(QLatin1String("p90"), histogram.percentile(0.9) * 1000);
+        times.insert(QLatin1String("p99"), histogram.percentile(0.99) * 1000);
+        statistics.insert(QLatin1String(JSC::GCPauseStatistics::phaseName(phase)), times);
+    }
+    return statistics;
+}
+
+/*!
+    Forgets the garbage collection times gathered so far.
+
+    \sa garbageCollectionStatistics()
+*/
+void QWebSettings::resetGarbageCollectionStatistics()
+{
+    WebCore::initializeWebCoreQt();
+    JSC::JSGlobalData* globalData = WebCore::JSDOMWindowBase::commonJSGlobalData();
+    JSC::JSLockHolder lock(globalData);
+    globalData->heap.clearPauseStatistics();
+}
+
+/*!
+    Returns, as a JSON document, how the JavaScript code run by the pages of
+    the main thread moved between the tiers of the JavaScript engine.
+
+    The document holds an array, codeBlocks, with an entry for each function,
+    and for each script, that was compiled to machine code. An entry holds
+    the hash identifying the code and its inferred name; when, in
+    milliseconds since the statistics were started, the code was first
+    compiled by the baseline and the optimizing compilers; how many times,
+    and for how long, each compiler ran; how many times the optimized code
+    was thrown away, by reason; and how many times the optimized code exited
+    to the baseline code, by kind of exit and by bytecode index.
+
+    The statistics are only gathered when the JSC_recordTierUpStatistics
+    environment variable is set to true, for at most 10000 pieces of code
+    unless JSC_maximumTierUpStatisticsRecords says otherwise. Code seen
+    after that is counted in droppedCodeBlocks.
+
+    \sa resetJavaScriptTierUpStatistics()
+*/
+QString QWebSettings::javaScriptTierUpStatistics()
+{
+    WebCore::initializeWebCoreQt();
+    JSC::JSGlobalData* globalData = WebCore::JSDOMWindowBase::commonJSGlobalData();
+    JSC::JSLockHolder lock(globalData);
+    return globalData->tierUpStatistics.toJSON(*globalData);
+}
+
+/*!
+    Forgets the JavaScript tier-up statistics gathered so far.
+
+    \sa javaScriptTierUpStatistics()
+*/
+void QWebSettings::resetJavaScriptTierUpStatistics()
+{
+    WebCore::initializeWebCoreQt();
+    JSC::JSGlobalData* globalData = WebCore::JSDOMWindowBase::commonJSGlobalData();
+    JSC::JSLockHolder lock(globalData);
+    globalData->tierUpStatistics.clear();
+}
+
 /*!
     Sets the maximum number of pages to hold in the memory page cache to \a pages.
 
@@ -26,6 +26,7 @@
 #include <QtGui/qpixmap.h>
 #include <QtGui/qicon.h>
 #include <QtCore/qshareddata.h>
+#include <QtCore/qvariant.h>
 
 namespace WebCore {
     class Settings;
@@ -154,6 +155,13 @@ public:
     QString localStoragePath() const; 
 
     static void clearMemoryCaches();
+    static void releaseMemoryUnderPressure();
+
+    static QVariantMap garbageCollectionStatistics();
+    static void resetGarbageCollectionStatistics();
+
+    static QString javaScriptTierUpStatistics();
+    static void resetJavaScriptTierUpStatistics();
 
     static void enablePersistentStorage(const QString& path = QString());
 
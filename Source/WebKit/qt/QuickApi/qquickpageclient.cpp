@@ -45,18 +45,19 @@ void PageClientQQuick::scroll(int dx, int dy, const QRect& rectToScroll)
     Q_UNUSED(dx);
     Q_UNUSED(dy);
     Q_UNUSED(rectToScroll);
-    view->update();
+    // The exposed area has to be rendered (or, in tiled mode, covered with
+    // tiles) before the view can show the new scroll position.
+    view->repaint();
+    emit view->scrollPositionChanged();
 }
 
 void PageClientQQuick::update(const QRect & dirtyRect)
 {
-    qDebug() << Q_FUNC_INFO << dirtyRect;
     view->repaint(dirtyRect);
 }
 
 void PageClientQQuick::repaintViewport()
 {
-    qDebug() << Q_FUNC_INFO;
     view->repaint();
 }
 
@@ -126,6 +127,23 @@ bool PageClientQQuick::viewResizesToContentsEnabled() const
     return view->resizesToContents();
 }
 
+QRectF PageClientQQuick::graphicsItemVisibleRect() const
+{
+    if (!view->window())
+        return QRectF();
+    QRectF windowRect(QPointF(), view->window()->size());
+    return view->mapRectFromScene(windowRect).intersected(view->boundingRect());
+}
+
+QRect PageClientQQuick::tiledBackingStoreVisibleRect() const
+{
+    // The view may be showing a scroll position the frame has not caught
+    // up with yet; the tiles have to follow what is on screen. While a
+    // resize is pending the page keeps its old viewport size.
+    const QSizeF visibleSize = QSizeF(page->viewportSize()) / view->contentsScale();
+    return QRect(view->scrollPosition(), visibleSize.toSize());
+}
+
 QRectF PageClientQQuick::windowRect() const
 {
     return QRectF(view->window()->geometry());
@@ -138,5 +156,19 @@ void PageClientQQuick::setWidgetVisible(Widget* widget, bool visible)
     return;
 }
 
+#if USE(ACCELERATED_COMPOSITING)
+void PageClientQQuick::didSyncCompositedLayers()
+{
+    // The layers go to their own texture, so the page contents stay as
+    // they are; only the composited image needs to be refreshed.
+    QMetaObject::invokeMethod(view, "_q_syncCompositedLayers");
+}
+
+void PageClientQQuick::didDetachCompositedLayers()
+{
+    QMetaObject::invokeMethod(view, "_q_clearCompositedLayers");
+}
+#endif
+
 } // namespace WebCore
 
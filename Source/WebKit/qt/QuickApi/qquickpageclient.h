@@ -75,10 +75,19 @@ public:
 
     virtual bool viewResizesToContentsEnabled() const;
 
+    virtual QRectF graphicsItemVisibleRect() const;
+    virtual QRect tiledBackingStoreVisibleRect() const;
+
     virtual QRectF windowRect() const;
 
     virtual void setWidgetVisible(Widget*, bool visible);
 
+#if USE(ACCELERATED_COMPOSITING)
+    virtual bool compositesLayersSeparately() const { return true; }
+    virtual void didSyncCompositedLayers();
+    virtual void didDetachCompositedLayers();
+#endif
+
     QQuickWebView* view;
     QWebPage* page;
 };
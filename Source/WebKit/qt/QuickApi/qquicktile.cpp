@@ -0,0 +1,419 @@
+/*
+ * Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "config.h"
+#include "qquicktile.h"
+
+#include "GraphicsContext.h"
+#include "TiledBackingStoreClient.h"
+#include <QPainter>
+#include <QPicture>
+#include <QRunnable>
+#include <QtAlgorithms>
+
+namespace WebCore {
+
+// Enough for about 128 tiles of the default size.
+static const qint64 defaultTileMemoryBudget = 128 * 1024 * 1024;
+
+// Buffers of destroyed tiles kept around for new tiles to reuse.
+static const int maxFreeBuffers = 8;
+
+TileQQuick::TileQQuick(TileQQuickClient* client, TileQQuickRasterizer* rasterizer, TiledBackingStore* backingStore, const Coordinate& tileCoordinate)
+    : m_client(client)
+    , m_rasterizer(rasterizer)
+    , m_backingStore(backingStore)
+    , m_coordinate(tileCoordinate)
+    , m_rect(backingStore->tileRectForCoordinate(tileCoordinate))
+    , m_ID(0)
+    , m_pendingJob(0)
+    , m_dirtyRegion(m_rect)
+{
+    TileQQuickPool::instance()->addTile(this);
+}
+
+TileQQuick::~TileQQuick()
+{
+    if (m_pendingJob)
+        m_rasterizer->cancel(m_pendingJob);
+    if (m_ID)
+        m_client->removeTile(m_ID);
+    TileQQuickPool* pool = TileQQuickPool::instance();
+    pool->removeTile(this);
+    if (!m_buffer.isNull())
+        pool->releaseBuffer(m_buffer);
+}
+
+bool TileQQuick::isDirty() const
+{
+    return !m_dirtyRegion.isEmpty();
+}
+
+bool TileQQuick::isReadyToPaint() const
+{
+    return m_ID;
+}
+
+void TileQQuick::invalidate(const IntRect& dirtyRect)
+{
+    IntRect tileDirtyRect = intersection(dirtyRect, m_rect);
+    if (tileDirtyRect.isEmpty())
+        return;
+
+    m_dirtyRegion += tileDirtyRect;
+}
+
+Vector<IntRect> TileQQuick::updateBackBuffer()
+{
+    if (!isDirty())
+        return Vector<IntRect>();
+
+    // Only one rasterization per tile is in flight at any time; whatever
+    // got dirty in the meantime is picked up when it has finished.
+    if (m_pendingJob)
+        return Vector<IntRect>();
+
+    if (m_buffer.isNull()) {
+        m_buffer = TileQQuickPool::instance()->acquireBuffer(QSize(m_rect.width(), m_rect.height()));
+        m_buffer.fill(m_backingStore->client()->tiledBackingStoreBackgroundColor());
+    }
+
+    QVector<QRect> dirtyRects = m_dirtyRegion.rects();
+    IntRect updateRect = m_dirtyRegion.boundingRect();
+    m_dirtyRegion = QRegion();
+
+    Vector<IntRect> updatedRects;
+    if (m_rasterizer) {
+        QPicture picture;
+        // Transparency layers are sized from the paint device, and a picture
+        // that is still being recorded only reports what was painted so far.
+        picture.setBoundingRect(QRect(QPoint(), QSize(m_rect.width(), m_rect.height())));
+        QPainter painter(&picture);
+        paintDirtyRects(&painter, dirtyRects, updatedRects);
+        painter.end();
+        m_pendingJob = m_rasterizer->rasterize(this, m_buffer, picture, updateRect);
+        // Nothing has been painted yet, didRasterize() reports the update.
+        return Vector<IntRect>();
+    }
+
+    // The scene graph may still hold a reference to the previous contents
+    // while they are being uploaded; painting then detaches our copy.
+    QPainter painter(&m_buffer);
+    paintDirtyRects(&painter, dirtyRects, updatedRects);
+    painter.end();
+
+    didUpdateBuffer(updateRect);
+    return updatedRects;
+}
+
+void TileQQuick::paintDirtyRects(QPainter* painter, const QVector<QRect>& dirtyRects, Vector<IntRect>& updatedRects)
+{
+    GraphicsContext context(painter);
+    context.translate(-m_rect.x(), -m_rect.y());
+
+    int size = dirtyRects.size();
+    for (int n = 0; n < size; ++n) {
+        context.save();
+        IntRect rect = dirtyRects[n];
+        updatedRects.append(rect);
+        context.clip(FloatRect(rect));
+        context.scale(FloatSize(m_backingStore->contentsScale(), m_backingStore->contentsScale()));
+        m_backingStore->client()->tiledBackingStorePaint(&context, m_backingStore->mapToContents(rect));
+        context.restore();
+    }
+}
+
+void TileQQuick::didUpdateBuffer(const IntRect& updateRect)
+{
+    TileQQuickPool::instance()->didUpdateTile(this);
+
+    static int id = 0;
+    if (!m_ID) {
+        m_ID = ++id;
+        m_client->createTile(this);
+    } else
+        m_client->updateTile(this, updateRect);
+}
+
+void TileQQuick::didRasterize(const QImage& buffer, const IntRect& updateRect)
+{
+    m_pendingJob = 0;
+    m_buffer = buffer;
+    // The tile may have been resized while the job was running.
+    if (m_buffer.size() != QSize(m_rect.width(), m_rect.height()))
+        m_buffer = m_buffer.copy(0, 0, m_rect.width(), m_rect.height());
+
+    didUpdateBuffer(updateRect);
+
+    if (isDirty())
+        m_backingStore->updateTileBuffers();
+}
+
+bool TileQQuick::isInCoverRect() const
+{
+    return m_rect.intersects(m_backingStore->coverRect());
+}
+
+void TileQQuick::evict()
+{
+    m_backingStore->removeTile(m_coordinate);
+}
+
+void TileQQuick::swapBackBufferToFront()
+{
+    // The buffer is painted in place; the view picks it up on the next scene graph sync.
+}
+
+void TileQQuick::paint(GraphicsContext* context, const IntRect& rect)
+{
+    if (m_buffer.isNull())
+        return;
+
+    IntRect target = intersection(rect, m_rect);
+    IntRect source((target.x() - m_rect.x()),
+                   (target.y() - m_rect.y()),
+                   target.width(),
+                   target.height());
+
+    context->platformContext()->drawImage(target, m_buffer, source);
+}
+
+void TileQQuick::resize(const IntSize& newSize)
+{
+    IntRect oldRect = m_rect;
+    m_rect = IntRect(m_rect.location(), newSize);
+    if (!m_buffer.isNull()) {
+        m_buffer = m_buffer.copy(0, 0, newSize.width(), newSize.height());
+        TileQQuickPool::instance()->didUpdateTile(this);
+    }
+    if (m_rect.maxX() > oldRect.maxX())
+        invalidate(IntRect(oldRect.maxX(), oldRect.y(), m_rect.maxX() - oldRect.maxX(), m_rect.height()));
+    if (m_rect.maxY() > oldRect.maxY())
+        invalidate(IntRect(oldRect.x(), oldRect.maxY(), m_rect.width(), m_rect.maxY() - oldRect.maxY()));
+}
+
+class TileQQuickRasterJob : public QRunnable {
+public:
+    TileQQuickRasterJob(TileQQuickRasterizer* rasterizer, unsigned jobID, const QImage& buffer, const QPicture& picture, const QRect& updateRect)
+        : m_rasterizer(rasterizer)
+        , m_jobID(jobID)
+        , m_buffer(buffer)
+        , m_picture(picture)
+        , m_updateRect(updateRect)
+    {
+    }
+
+    virtual void run()
+    {
+        // Painting detaches the buffer from the tile's front buffer, which
+        // stays untouched until the result is handed back on the GUI thread.
+        // Text is scaled by the ratio between the resolution the picture was
+        // recorded at and the target's; keep them equal so it replays 1:1.
+        m_buffer.setDotsPerMeterX(qRound(m_picture.logicalDpiX() / 0.0254));
+        m_buffer.setDotsPerMeterY(qRound(m_picture.logicalDpiY() / 0.0254));
+
+        QPainter painter(&m_buffer);
+        painter.drawPicture(0, 0, m_picture);
+        painter.end();
+
+        // The rasterizer waits for all jobs before it goes away, and pending
+        // deliveries are dropped along with it.
+        QMetaObject::invokeMethod(m_rasterizer, "jobFinished", Qt::QueuedConnection,
+            Q_ARG(uint, m_jobID), Q_ARG(QImage, m_buffer), Q_ARG(QRect, m_updateRect));
+    }
+
+private:
+    TileQQuickRasterizer* m_rasterizer;
+    unsigned m_jobID;
+    QImage m_buffer;
+    QPicture m_picture;
+    QRect m_updateRect;
+};
+
+TileQQuickRasterizer::TileQQuickRasterizer(int threadCount, QObject* parent)
+    : QObject(parent)
+    , m_lastJobID(0)
+{
+    m_threadPool.setMaxThreadCount(threadCount);
+}
+
+TileQQuickRasterizer::~TileQQuickRasterizer()
+{
+    m_threadPool.waitForDone();
+}
+
+unsigned TileQQuickRasterizer::rasterize(TileQQuick* tile, const QImage& buffer, const QPicture& picture, const IntRect& updateRect)
+{
+    unsigned jobID = ++m_lastJobID;
+    if (!jobID)
+        jobID = ++m_lastJobID;
+    m_pendingJobs.insert(jobID, tile);
+    m_threadPool.start(new TileQQuickRasterJob(this, jobID, buffer, picture, updateRect));
+    return jobID;
+}
+
+void TileQQuickRasterizer::cancel(unsigned jobID)
+{
+    // The job itself still runs, but its result is thrown away.
+    m_pendingJobs.remove(jobID);
+}
+
+void TileQQuickRasterizer::jobFinished(uint jobID, const QImage& buffer, const QRect& updateRect)
+{
+    TileQQuick* tile = m_pendingJobs.take(jobID);
+    if (!tile)
+        return;
+    tile->didRasterize(buffer, updateRect);
+}
+
+TileQQuickPool* TileQQuickPool::instance()
+{
+    static TileQQuickPool* pool = new TileQQuickPool;
+    return pool;
+}
+
+TileQQuickPool::TileQQuickPool()
+    : m_budget(defaultTileMemoryBudget)
+    , m_usage(0)
+    , m_useCounter(0)
+    , m_evictionScheduled(false)
+{
+}
+
+void TileQQuickPool::setBudget(qint64 bytes)
+{
+    m_budget = qMax(qint64(0), bytes);
+    scheduleEviction();
+}
+
+QImage TileQQuickPool::acquireBuffer(const QSize& size)
+{
+    for (int i = 0; i < m_freeBuffers.size(); ++i) {
+        if (m_freeBuffers.at(i).size() != size)
+            continue;
+        QImage buffer = m_freeBuffers.takeAt(i);
+        m_usage -= buffer.byteCount();
+        return buffer;
+    }
+    return QImage(size, QImage::Format_ARGB32_Premultiplied);
+}
+
+void TileQQuickPool::releaseBuffer(const QImage& buffer)
+{
+    if (m_freeBuffers.size() >= maxFreeBuffers || m_usage + buffer.byteCount() > m_budget)
+        return;
+    m_freeBuffers.append(buffer);
+    m_usage += buffer.byteCount();
+}
+
+void TileQQuickPool::addTile(TileQQuick* tile)
+{
+    m_tiles.insert(tile, TileEntry());
+}
+
+void TileQQuickPool::removeTile(TileQQuick* tile)
+{
+    m_usage -= m_tiles.take(tile).bytes;
+}
+
+void TileQQuickPool::didUpdateTile(TileQQuick* tile)
+{
+    TileEntry& entry = m_tiles[tile];
+    qint64 bytes = tile->buffer().byteCount();
+    m_usage += bytes - entry.bytes;
+    entry.bytes = bytes;
+    entry.lastUse = ++m_useCounter;
+    scheduleEviction();
+}
+
+void TileQQuickPool::scheduleEviction()
+{
+    if (m_evictionScheduled || m_usage <= m_budget)
+        return;
+    // Evicting from within the backing store's own update would pull tiles
+    // out from under it, so wait until it has returned.
+    m_evictionScheduled = true;
+    QMetaObject::invokeMethod(this, "evictTiles", Qt::QueuedConnection);
+}
+
+struct EvictionCandidate {
+    int priority;
+    quint64 lastUse;
+    TileQQuick* tile;
+
+    bool operator<(const EvictionCandidate& other) const
+    {
+        if (priority != other.priority)
+            return priority < other.priority;
+        return lastUse < other.lastUse;
+    }
+};
+
+void TileQQuickPool::evictTiles()
+{
+    m_evictionScheduled = false;
+
+    while (m_usage > m_budget && !m_freeBuffers.isEmpty())
+        m_usage -= m_freeBuffers.takeLast().byteCount();
+    if (m_usage <= m_budget)
+        return;
+
+    QVector<EvictionCandidate> candidates;
+    QHash<TileQQuick*, TileEntry>::const_iterator end = m_tiles.constEnd();
+    for (QHash<TileQQuick*, TileEntry>::const_iterator it = m_tiles.constBegin(); it != end; ++it) {
+        TileQQuick* tile = it.key();
+        if (!it.value().bytes)
+            continue;
+        TileQQuickClient::TilePriority priority = tile->client()->tilePriority();
+        // Hidden views have their backing store frozen, so none of their
+        // tiles come back until they are shown again.
+        if (priority != TileQQuickClient::HiddenTilePriority && tile->isInCoverRect())
+            continue;
+        EvictionCandidate candidate = { priority, it.value().lastUse, tile };
+        candidates.append(candidate);
+    }
+    qSort(candidates);
+
+    for (int i = 0; i < candidates.size() && m_usage > m_budget; ++i) {
+        // Evicting a tile destroys it, which takes it out of m_tiles.
+        if (m_tiles.contains(candidates.at(i).tile))
+            candidates.at(i).tile->evict();
+    }
+}
+
+TileQQuickBackend::TileQQuickBackend(TileQQuickClient* client, TileQQuickRasterizer* rasterizer)
+    : m_client(client)
+    , m_rasterizer(rasterizer)
+{
+}
+
+PassRefPtr<Tile> TileQQuickBackend::createTile(TiledBackingStore* backingStore, const Tile::Coordinate& tileCoordinate)
+{
+    return TileQQuick::create(m_client, m_rasterizer, backingStore, tileCoordinate);
+}
+
+void TileQQuickBackend::paintCheckerPattern(GraphicsContext*, const FloatRect&)
+{
+    // Uncovered areas are simply left out of the scene graph.
+}
+
+}
+
+#include "moc_qquicktile.cpp"
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef QQUICKTILE_H
+#define QQUICKTILE_H
+
+#include "IntRect.h"
+#include "Tile.h"
+#include "TiledBackingStore.h"
+#include "TiledBackingStoreBackend.h"
+#include <QHash>
+#include <QImage>
+#include <QList>
+#include <QObject>
+#include <QRegion>
+#include <QThreadPool>
+
+QT_BEGIN_NAMESPACE
+class QPainter;
+class QPicture;
+QT_END_NAMESPACE
+
+namespace WebCore {
+
+class TileQQuickClient;
+class TileQQuickRasterizer;
+
+// A tile of the main frame's TiledBackingStore that rasterizes into a QImage
+// and hands the result over to the QQuickWebView, which publishes it as a
+// scene graph texture instead of painting it with QPainter.
+class TileQQuick : public Tile {
+public:
+    static PassRefPtr<Tile> create(TileQQuickClient* client, TileQQuickRasterizer* rasterizer, TiledBackingStore* backingStore, const Coordinate& tileCoordinate) { return adoptRef(new TileQQuick(client, rasterizer, backingStore, tileCoordinate)); }
+    ~TileQQuick();
+
+    bool isDirty() const;
+    void invalidate(const IntRect&);
+    Vector<IntRect> updateBackBuffer();
+    void swapBackBufferToFront();
+    bool isReadyToPaint() const;
+    void paint(GraphicsContext*, const IntRect&);
+
+    const Tile::Coordinate& coordinate() const { return m_coordinate; }
+    const IntRect& rect() const { return m_rect; }
+    void resize(const IntSize&);
+
+    int id() const { return m_ID; }
+    const QImage& buffer() const { return m_buffer; }
+    TileQQuickClient* client() const { return m_client; }
+
+    // Whether the tile intersects the cover rect of its backing store, which
+    // would create it again as soon as it was evicted.
+    bool isInCoverRect() const;
+    // Drops the tile from its backing store, which destroys it.
+    void evict();
+
+    void didRasterize(const QImage&, const IntRect& updateRect);
+
+private:
+    TileQQuick(TileQQuickClient*, TileQQuickRasterizer*, TiledBackingStore*, const Coordinate&);
+
+    void paintDirtyRects(QPainter*, const QVector<QRect>& dirtyRects, Vector<IntRect>& updatedRects);
+    void didUpdateBuffer(const IntRect& updateRect);
+
+    TileQQuickClient* m_client;
+    TileQQuickRasterizer* m_rasterizer;
+    TiledBackingStore* m_backingStore;
+    Coordinate m_coordinate;
+    IntRect m_rect;
+
+    int m_ID;
+    unsigned m_pendingJob;
+    QImage m_buffer;
+    QRegion m_dirtyRegion;
+};
+
+class TileQQuickClient {
+public:
+    enum TilePriority {
+        HiddenTilePriority,
+        VisibleTilePriority,
+        FocusedTilePriority
+    };
+
+    virtual ~TileQQuickClient() { }
+    virtual void createTile(TileQQuick*) = 0;
+    virtual void updateTile(TileQQuick*, const IntRect& updateRect) = 0;
+    virtual void removeTile(int tileID) = 0;
+    virtual TilePriority tilePriority() const { return VisibleTilePriority; }
+};
+
+// Accounts for the memory held by the tiles of all views in the process,
+// against a single budget. When it is exceeded, tiles are evicted from
+// their backing store, least recently updated first and starting with the
+// views that matter least: any tile of a hidden view, and the tiles
+// outside the cover rect of the others. Tiles inside the cover rect of a
+// visible view are never evicted, since its backing store would create them
+// again on its next pass. The buffers of destroyed tiles are recycled.
+// GUI thread only.
+class TileQQuickPool : public QObject {
+    Q_OBJECT
+public:
+    static TileQQuickPool* instance();
+
+    qint64 budget() const { return m_budget; }
+    void setBudget(qint64 bytes);
+    qint64 usage() const { return m_usage; }
+
+    QImage acquireBuffer(const QSize&);
+    void releaseBuffer(const QImage&);
+
+    void addTile(TileQQuick*);
+    void removeTile(TileQQuick*);
+    void didUpdateTile(TileQQuick*);
+
+private Q_SLOTS:
+    void evictTiles();
+
+private:
+    TileQQuickPool();
+    void scheduleEviction();
+
+    struct TileEntry {
+        TileEntry() : bytes(0), lastUse(0) { }
+        qint64 bytes;
+        quint64 lastUse;
+    };
+
+    qint64 m_budget;
+    qint64 m_usage;
+    quint64 m_useCounter;
+    bool m_evictionScheduled;
+    QHash<TileQQuick*, TileEntry> m_tiles;
+    QList<QImage> m_freeBuffers;
+};
+
+// Replays the paint recorded for dirty tiles on a pool of worker threads,
+// so that rasterization does not eat into the GUI thread's frame budget.
+// Only the recording, which is cheap, happens on the GUI thread.
+class TileQQuickRasterizer : public QObject {
+    Q_OBJECT
+public:
+    explicit TileQQuickRasterizer(int threadCount, QObject* parent = 0);
+    ~TileQQuickRasterizer();
+
+    int threadCount() const { return m_threadPool.maxThreadCount(); }
+
+    unsigned rasterize(TileQQuick*, const QImage& buffer, const QPicture&, const IntRect& updateRect);
+    void cancel(unsigned jobID);
+
+private Q_SLOTS:
+    void jobFinished(uint jobID, const QImage& buffer, const QRect& updateRect);
+
+private:
+    QThreadPool m_threadPool;
+    QHash<unsigned, TileQQuick*> m_pendingJobs;
+    unsigned m_lastJobID;
+};
+
+class TileQQuickBackend : public TiledBackingStoreBackend {
+public:
+    static PassOwnPtr<TiledBackingStoreBackend> create(TileQQuickClient* client, TileQQuickRasterizer* rasterizer = 0) { return adoptPtr(new TileQQuickBackend(client, rasterizer)); }
+    PassRefPtr<Tile> createTile(TiledBackingStore*, const Tile::Coordinate&);
+    void paintCheckerPattern(GraphicsContext*, const FloatRect&);
+
+private:
+    TileQQuickBackend(TileQQuickClient*, TileQQuickRasterizer*);
+    TileQQuickClient* m_client;
+    TileQQuickRasterizer* m_rasterizer;
+};
+
+}
+
+#endif // QQUICKTILE_H
@@ -22,19 +22,56 @@
 #include "config.h"
 #include "qquickwebview.h"
 
+#include "Document.h"
+#include "Frame.h"
+#include "FrameTree.h"
+#include "FrameView.h"
+#include "GraphicsContext.h"
+#include "QWebFrameAdapter.h"
 #include "QWebPageClient.h"
+#include "TiledBackingStore.h"
+#include "qquicktile.h"
+#include "qquickwebviewnode_p.h"
 #include "qwebframe.h"
 #include "qwebpage_p.h"
+#include "qwebsettings.h"
 #ifndef QT_NO_ACCESSIBILITY
 #include "qwebviewaccessible_p.h"
 #endif
 #include <qbitmap.h>
 #include <qdir.h>
+#include <qelapsedtimer.h>
 #include <qevent.h>
 #include <qfile.h>
 #include <qpainter.h>
+#include <qquickwindow.h>
+#include <qscreen.h>
+#include <qscopedpointer.h>
+#include <qset.h>
+#include <qtimer.h>
 
-class QQuickWebViewPrivate {
+// Beyond this many rectangles the damage is tracked as its bounding rect.
+static const int maxRepaintRects = 10;
+
+// The bounding rect is painted instead of the individual rectangles when
+// it wastes no more than this fraction of its area (see QWebFrameAdapter).
+static const float wastedSpaceThreshold = 0.75f;
+
+// How long the view may show a scroll position ahead of the main frame
+// before the frame is scrolled to it, in milliseconds.
+static const int scrollSyncDelay = 50;
+
+// How long the contents scale has to stay put before the tiles are
+// rasterized again at that scale, in milliseconds.
+static const int scaleCommitDelay = 150;
+
+// Number of frames QQuickWebView::frameTimings() remembers by default.
+static const int defaultFrameTimingHistorySize = 120;
+
+// Used when the screen does not report its refresh rate.
+static const qreal defaultRefreshRate = 60;
+
+class QQuickWebViewPrivate : public WebCore::TileQQuickClient {
 public:
     QQuickWebViewPrivate(QQuickWebView *view)
         : q(view)
@@ -42,6 +79,23 @@ public:
         , repaintQueued(false)
         , inputMethodHints(Qt::ImhNone)
         , resizesToContents(false)
+        , tiledRendering(false)
+        , pendingPaintedPixels(0)
+        , paintedPixels(0)
+        , compositedLayersDirty(false)
+        , scrollPending(false)
+        , resizeDelay(0)
+        , contentsScale(1)
+        , hasRetiredTiles(false)
+        , retireTiles(false)
+        , retiredTileScale(1)
+        , removeRetiredTiles(false)
+        , frameTimingHistorySize(defaultFrameTimingHistorySize)
+        , frameTimingStart(0)
+        , frameNumber(0)
+        , lastLayoutTime(0)
+        , lastStyleRecalcTime(0)
+        , lastPaintTime(0)
         , renderHints(QPainter::TextAntialiasing | QPainter::SmoothPixmapTransform)
     {
         Q_ASSERT(view);
@@ -50,21 +104,103 @@ public:
     virtual ~QQuickWebViewPrivate();
 
     void updateResizesToContentsForPage();
+    void updateTiledBackingStoreForPage();
+    WebCore::TiledBackingStore* tiledBackingStore() const;
+
+    // TileQQuickClient
+    virtual void createTile(WebCore::TileQQuick*);
+    virtual void updateTile(WebCore::TileQQuick*, const WebCore::IntRect&);
+    virtual void removeTile(int tileID);
+    virtual TilePriority tilePriority() const;
 
     void _q_pageDestroyed();
     void _q_repaintReal();
     void _q_contentsSizeChanged(const QSize&);
+    void _q_syncCompositedLayers();
+    void _q_clearCompositedLayers();
+    void _q_syncScrollPosition();
+    void _q_applyViewportSize();
+    qreal previewScale() const;
+    void _q_commitContentsScale();
+    void _q_updateBackingStoreFrozen();
+    qreal tileScale() const;
+    QPointF mapToFrame(const QPointF&) const;
+    void sendMouseEvent(QMouseEvent*);
+    void sendHoverEvent(QHoverEvent*);
+
+    void damaged();
+    void recordFrameTiming(qint64 dirtyArea, qint64 uploadBytes);
     void detachCurrentPage();
 
     QQuickWebView *q;
     QWebPage *page;
 
     bool repaintQueued;
-    QRect repaintRect;
+    QRegion repaintRegion;
     Qt::InputMethodHints inputMethodHints;
     bool resizesToContents;
+    bool tiledRendering;
+    qint64 pendingPaintedPixels;
+    qint64 paintedPixels;
     QPainter::RenderHints renderHints;
     QPixmap renderedPage;
+    QScopedPointer<WebCore::TileQQuickRasterizer> rasterizer;
+
+    // Tiles of the main frame's backing store, and the changes the scene
+    // graph has not picked up yet. Only touched on the GUI thread, or from
+    // updatePaintNode() while the GUI thread is blocked.
+    QHash<int, WebCore::TileQQuick*> tiles;
+    QSet<int> dirtyTiles;
+    QList<int> removedTiles;
+
+    // The accelerated compositing layers, composited over the page
+    // contents in viewport coordinates. A null image means no layers.
+    QImage compositedLayers;
+    bool compositedLayersDirty;
+
+    // In tiled mode the view scrolls ahead of the main frame: the scene
+    // graph moves the existing tiles straight away, and the frame is told
+    // once the position has settled.
+    bool scrollPending;
+    QPoint pendingScrollPosition;
+    QTimer scrollSyncTimer;
+
+    // With a resize delay, the page keeps its viewport size while the
+    // item is being resized and the last rendering is shown scaled.
+    int resizeDelay;
+    QTimer resizeTimer;
+
+    // While the contents scale changes the tiles are frozen and shown
+    // scaled. Once it settles they are rasterized again at the new scale,
+    // and the old ones stay visible below them until the view is covered.
+    qreal contentsScale;
+    QTimer scaleCommitTimer;
+    bool hasRetiredTiles;
+    bool retireTiles;
+    qreal retiredTileScale;
+    bool removeRetiredTiles;
+
+    struct FrameTiming {
+        qint64 frame;
+        double layoutTime;
+        double styleRecalcTime;
+        double paintTime;
+        qint64 uploadBytes;
+        qint64 dirtyArea;
+        int droppedFrames;
+    };
+
+    // Ring buffer of the most recent frames, recorded in updatePaintNode().
+    // The WebCore counters only ever grow for a given document, so each
+    // frame records how much they moved since the previous one.
+    QVector<FrameTiming> frameTimings;
+    int frameTimingHistorySize;
+    int frameTimingStart;
+    qint64 frameNumber;
+    double lastLayoutTime;
+    double lastStyleRecalcTime;
+    double lastPaintTime;
+    QElapsedTimer damageTimer;
 };
 
 QQuickWebViewPrivate::~QQuickWebViewPrivate()
@@ -78,20 +214,253 @@ void QQuickWebViewPrivate::_q_pageDestroyed()
     q->setPage(0);
 }
 
+static void coalesceRepaintRects(const QRect& boundingRect, QVector<QRect>& rects)
+{
+    if (rects.size() <= 1)
+        return;
+
+    float unionPixels = boundingRect.width() * boundingRect.height();
+    float singlePixels = 0;
+    for (int i = 0; i < rects.size(); ++i)
+        singlePixels += rects[i].width() * rects[i].height();
+    if (1 - (singlePixels / unionPixels) > wastedSpaceThreshold)
+        return;
+
+    rects.clear();
+    rects.append(boundingRect);
+}
+
 void QQuickWebViewPrivate::_q_repaintReal()
 {
-    qDebug() << Q_FUNC_INFO << "start" << repaintRect;
     repaintQueued = false;
-    QPainter p;
-    if (!p.begin(&renderedPage)) {
-        qDebug() << "Painter error!";
+    if (tiledRendering) {
+        // The tiles repaint themselves; we only need to make sure the
+        // visible area is covered and let the scene graph pick them up.
+        if (WebCore::TiledBackingStore* backingStore = tiledBackingStore())
+            backingStore->coverWithTilesIfNeeded();
+        repaintRegion = QRegion();
+        q->update();
         return;
     }
+
+    QVector<QRect> rects = repaintRegion.rects();
+    coalesceRepaintRects(repaintRegion.boundingRect(), rects);
+    repaintRegion = QRegion();
+    if (!page || rects.isEmpty())
+        return;
+
+    QPainter p;
+    if (!p.begin(&renderedPage))
+        return;
+    QRegion clip;
+    clip.setRects(rects.constData(), rects.size());
     QWebFrame *frame = page->mainFrame();
-    frame->render(&p, QWebFrame::ContentsLayer, QRegion(repaintRect));
-    q->update(repaintRect);
-    repaintRect = QRect();
-    qDebug() << Q_FUNC_INFO << "end";
+    frame->render(&p, QWebFrame::ContentsLayer, clip);
+    p.end();
+
+    for (int i = 0; i < rects.size(); ++i) {
+        pendingPaintedPixels += qint64(rects[i].width()) * rects[i].height();
+        q->update(rects[i]);
+    }
+}
+
+void QQuickWebViewPrivate::_q_syncCompositedLayers()
+{
+    QSize size = page ? page->viewportSize() : QSize();
+    if (size.isEmpty()) {
+        _q_clearCompositedLayers();
+        return;
+    }
+
+    if (compositedLayers.size() != size)
+        compositedLayers = QImage(size, QImage::Format_ARGB32_Premultiplied);
+    compositedLayers.fill(Qt::transparent);
+
+#if USE(ACCELERATED_COMPOSITING)
+    QPainter painter(&compositedLayers);
+    painter.setRenderHints(renderHints);
+    WebCore::GraphicsContext context(&painter);
+    page->d->mainFrameAdapter()->renderCompositedLayers(&context, WebCore::IntRect(QRect(QPoint(), size)));
+#endif
+
+    damaged();
+    pendingPaintedPixels += qint64(size.width()) * size.height();
+    compositedLayersDirty = true;
+    q->update();
+}
+
+void QQuickWebViewPrivate::_q_clearCompositedLayers()
+{
+    if (compositedLayers.isNull())
+        return;
+    compositedLayers = QImage();
+    compositedLayersDirty = true;
+    q->update();
+}
+
+void QQuickWebViewPrivate::_q_syncScrollPosition()
+{
+    scrollSyncTimer.stop();
+    if (!scrollPending)
+        return;
+    scrollPending = false;
+    if (page) {
+        QWebFrame* frame = page->mainFrame();
+        frame->setScrollPosition(pendingScrollPosition);
+        // When zoomed in, the view can scroll further than the frame; it
+        // then keeps the position itself.
+        scrollPending = contentsScale != 1 && frame->scrollPosition() != pendingScrollPosition;
+    }
+    if (WebCore::TiledBackingStore* backingStore = tiledBackingStore())
+        backingStore->coverWithTilesIfNeeded();
+}
+
+void QQuickWebViewPrivate::_q_commitContentsScale()
+{
+    scaleCommitTimer.stop();
+    WebCore::TiledBackingStore* backingStore = tiledBackingStore();
+    if (!backingStore)
+        return;
+
+    if (backingStore->contentsScale() != contentsScale) {
+        retireTiles = true;
+        retiredTileScale = backingStore->contentsScale();
+        hasRetiredTiles = true;
+        backingStore->setContentsScale(contentsScale);
+    }
+    // Thawing commits the new scale, which replaces all the tiles.
+    _q_updateBackingStoreFrozen();
+    q->update();
+}
+
+void QQuickWebViewPrivate::_q_updateBackingStoreFrozen()
+{
+    // Hidden views neither paint nor create tiles, which would only be
+    // evicted again by the tile pool.
+    if (WebCore::TiledBackingStore* backingStore = tiledBackingStore())
+        backingStore->setContentsFrozen(!q->isVisible() || scaleCommitTimer.isActive());
+}
+
+qreal QQuickWebViewPrivate::tileScale() const
+{
+    WebCore::TiledBackingStore* backingStore = tiledBackingStore();
+    return backingStore ? backingStore->contentsScale() : 1;
+}
+
+QPointF QQuickWebViewPrivate::mapToFrame(const QPointF& pos) const
+{
+    // The frame only knows about its own, unscaled, scroll position.
+    const QPoint frameScrollPosition = page->mainFrame()->scrollPosition();
+    return QPointF(q->scrollPosition() - frameScrollPosition) + pos / contentsScale;
+}
+
+void QQuickWebViewPrivate::sendMouseEvent(QMouseEvent* ev)
+{
+    if (!tiledRendering || contentsScale == 1) {
+        page->event(ev);
+        return;
+    }
+    QMouseEvent mappedEvent(ev->type(), mapToFrame(ev->localPos()), ev->windowPos(), ev->screenPos(),
+                            ev->button(), ev->buttons(), ev->modifiers());
+    page->event(&mappedEvent);
+}
+
+void QQuickWebViewPrivate::sendHoverEvent(QHoverEvent* ev)
+{
+    if (!tiledRendering || contentsScale == 1) {
+        page->event(ev);
+        return;
+    }
+    QHoverEvent mappedEvent(ev->type(), mapToFrame(ev->posF()), mapToFrame(ev->oldPosF()), ev->modifiers());
+    page->event(&mappedEvent);
+}
+
+void QQuickWebViewPrivate::_q_applyViewportSize()
+{
+    resizeTimer.stop();
+    const QSize size(q->width(), q->height());
+    if (!tiledRendering && (renderedPage.width() < size.width() || renderedPage.height() < size.height())) {
+        // Only ever grow the pixmap, keeping what was rendered so far on
+        // screen until the exposed area has been painted.
+        QPixmap pixmap(size.expandedTo(renderedPage.size()));
+        pixmap.fill(Qt::transparent);
+        QPainter painter(&pixmap);
+        painter.drawPixmap(0, 0, renderedPage);
+        painter.end();
+        renderedPage = pixmap;
+    }
+    if (page && page->viewportSize() != size) {
+        page->setViewportSize(size);
+        q->repaint();
+    }
+    q->update();
+}
+
+qreal QQuickWebViewPrivate::previewScale() const
+{
+    if (!resizeTimer.isActive() || !page || page->viewportSize().isEmpty())
+        return 1;
+    return q->width() / page->viewportSize().width();
+}
+
+void QQuickWebViewPrivate::damaged()
+{
+    if (!damageTimer.isValid())
+        damageTimer.start();
+}
+
+static inline double counterDelta(double& last, double current)
+{
+    // A counter that went backwards belongs to a new document or view.
+    double delta = current >= last ? current - last : current;
+    last = current;
+    return delta;
+}
+
+void QQuickWebViewPrivate::recordFrameTiming(qint64 dirtyArea, qint64 uploadBytes)
+{
+    if (!frameTimingHistorySize)
+        return;
+
+    double layoutTime = 0;
+    double styleRecalcTime = 0;
+    double paintTime = 0;
+    if (page) {
+        for (WebCore::Frame* frame = page->d->mainFrameAdapter()->frame; frame; frame = frame->tree()->traverseNext()) {
+            if (WebCore::FrameView* view = frame->view()) {
+                layoutTime += view->totalLayoutTime();
+                paintTime += view->totalPaintTime();
+            }
+            if (WebCore::Document* document = frame->document())
+                styleRecalcTime += document->totalStyleRecalcTime();
+        }
+    }
+
+    FrameTiming timing;
+    timing.frame = frameNumber++;
+    timing.layoutTime = counterDelta(lastLayoutTime, layoutTime) * 1000;
+    timing.styleRecalcTime = counterDelta(lastStyleRecalcTime, styleRecalcTime) * 1000;
+    timing.paintTime = counterDelta(lastPaintTime, paintTime) * 1000;
+    timing.uploadBytes = uploadBytes;
+    timing.dirtyArea = dirtyArea;
+
+    // Every refresh that went by between the first damage and this frame
+    // without showing it counts as dropped.
+    timing.droppedFrames = 0;
+    if (damageTimer.isValid()) {
+        qreal refreshRate = q->window() && q->window()->screen() ? q->window()->screen()->refreshRate() : 0;
+        if (refreshRate <= 0)
+            refreshRate = defaultRefreshRate;
+        timing.droppedFrames = qMax(0, int(damageTimer.elapsed() * refreshRate / 1000) - 1);
+        damageTimer.invalidate();
+    }
+
+    if (frameTimings.size() < frameTimingHistorySize)
+        frameTimings.append(timing);
+    else {
+        frameTimings[frameTimingStart] = timing;
+        frameTimingStart = (frameTimingStart + 1) % frameTimingHistorySize;
+    }
 }
 
 void QQuickWebViewPrivate::updateResizesToContentsForPage()
@@ -117,6 +486,58 @@ void QQuickWebViewPrivate::_q_contentsSizeChanged(const QSize& size)
     q->setContentsSize(size);
 }
 
+void QQuickWebViewPrivate::updateTiledBackingStoreForPage()
+{
+    ASSERT(page);
+    page->settings()->setAttribute(QWebSettings::TiledBackingStoreEnabled, tiledRendering);
+    if (WebCore::TiledBackingStore* backingStore = tiledBackingStore()) {
+        backingStore->setBackend(WebCore::TileQQuickBackend::create(this, rasterizer.data()));
+        backingStore->setContentsScale(contentsScale);
+        _q_updateBackingStoreFrozen();
+    }
+}
+
+WebCore::TiledBackingStore* QQuickWebViewPrivate::tiledBackingStore() const
+{
+    if (!page)
+        return 0;
+    return page->d->mainFrameAdapter()->frame->tiledBackingStore();
+}
+
+void QQuickWebViewPrivate::createTile(WebCore::TileQQuick* tile)
+{
+    pendingPaintedPixels += qint64(tile->rect().width()) * tile->rect().height();
+    tiles.insert(tile->id(), tile);
+    dirtyTiles.insert(tile->id());
+    if (hasRetiredTiles && tiledBackingStore()->visibleAreaIsCovered()) {
+        hasRetiredTiles = false;
+        removeRetiredTiles = true;
+    }
+    q->update();
+}
+
+void QQuickWebViewPrivate::updateTile(WebCore::TileQQuick* tile, const WebCore::IntRect& updateRect)
+{
+    pendingPaintedPixels += qint64(updateRect.width()) * updateRect.height();
+    dirtyTiles.insert(tile->id());
+    q->update();
+}
+
+WebCore::TileQQuickClient::TilePriority QQuickWebViewPrivate::tilePriority() const
+{
+    if (!q->isVisible())
+        return HiddenTilePriority;
+    return q->hasActiveFocus() ? FocusedTilePriority : VisibleTilePriority;
+}
+
+void QQuickWebViewPrivate::removeTile(int tileID)
+{
+    tiles.remove(tileID);
+    dirtyTiles.remove(tileID);
+    removedTiles.append(tileID);
+    q->update();
+}
+
 /*!
     \class QQuickWebView
     \since 4.4
@@ -229,6 +650,19 @@ QQuickWebView::QQuickWebView(QQuickItem *parent)
              QQuickItem::ItemAcceptsDrops);
     setAcceptHoverEvents(true);
     setAcceptedMouseButtons(Qt::LeftButton);
+
+    d->scrollSyncTimer.setSingleShot(true);
+    d->scrollSyncTimer.setInterval(scrollSyncDelay);
+    connect(&d->scrollSyncTimer, SIGNAL(timeout()), this, SLOT(_q_syncScrollPosition()));
+
+    d->resizeTimer.setSingleShot(true);
+    connect(&d->resizeTimer, SIGNAL(timeout()), this, SLOT(_q_applyViewportSize()));
+
+    d->scaleCommitTimer.setSingleShot(true);
+    d->scaleCommitTimer.setInterval(scaleCommitDelay);
+    connect(&d->scaleCommitTimer, SIGNAL(timeout()), this, SLOT(_q_commitContentsScale()));
+
+    connect(this, SIGNAL(visibleChanged()), this, SLOT(_q_updateBackingStoreFrozen()));
 }
 
 /*!
@@ -260,6 +694,16 @@ void QQuickWebViewPrivate::detachCurrentPage()
 
     page->d->view = 0;
 
+    scrollSyncTimer.stop();
+    scrollPending = false;
+
+    compositedLayers = QImage();
+    compositedLayersDirty = true;
+
+    // Our tiles must not outlive us if the page does.
+    if (tiledRendering)
+        page->settings()->setAttribute(QWebSettings::TiledBackingStoreEnabled, false);
+
     // if the page client is the special client constructed for
     // delegating the responsibilities to a QWidget, we need
     // to destroy it.
@@ -305,6 +749,9 @@ void QQuickWebView::setPage(QWebPage* page)
         if (d->resizesToContents)
             d->updateResizesToContentsForPage();
 
+        if (d->tiledRendering)
+            d->updateTiledBackingStoreForPage();
+
         // #### connect signals
         QWebFrame *mainFrame = d->page->mainFrame();
         connect(mainFrame, SIGNAL(titleChanged(QString)),
@@ -460,7 +907,6 @@ QString QQuickWebView::title() const
 
 void QQuickWebView::setUrl(const QUrl &url)
 {
-    qDebug() << Q_FUNC_INFO << url;
     page()->mainFrame()->setUrl(url);
 }
 
@@ -726,6 +1172,345 @@ void QQuickWebView::setRenderHint(QPainter::RenderHint hint, bool enabled)
         update();
 }
 
+/*!
+    \property QQuickWebView::tiledRendering
+    \brief whether the view renders the page through scene graph tiles
+
+    By default the page is rendered into a single pixmap the size of the
+    view, which is uploaded again whenever any part of it changes.
+
+    If this property is set, the main frame is rendered through WebCore's
+    tiled backing store instead. Every tile is published as its own texture
+    node, so only the tiles touched by an update are re-rasterized and
+    re-uploaded, and scrolling merely moves the existing tiles.
+
+    By default, this property is false.
+
+    \sa QWebSettings::TiledBackingStoreEnabled
+*/
+void QQuickWebView::setTiledRendering(bool enabled)
+{
+    if (d->tiledRendering == enabled)
+        return;
+    d->tiledRendering = enabled;
+    d->renderedPage = enabled ? QPixmap() : QPixmap(QSize(width(), height()));
+    if (d->page)
+        d->updateTiledBackingStoreForPage();
+    repaint();
+}
+
+bool QQuickWebView::tiledRendering() const
+{
+    return d->tiledRendering;
+}
+
+/*!
+    \property QQuickWebView::rasterizationThreads
+    \brief the number of worker threads rasterizing tiles
+
+    When tiledRendering is enabled and this property is greater than zero,
+    the GUI thread only records the paint commands for each dirty tile. The
+    recordings are replayed into the tile images by a pool of this many
+    worker threads, and the finished tiles are then handed to the scene
+    graph. This keeps expensive paints from blocking QML animations.
+
+    Painting on worker threads requires a platform that supports using
+    pixmaps outside of the GUI thread.
+
+    By default, this property is 0 and tiles are rasterized on the GUI thread.
+
+    \sa tiledRendering, QThread::idealThreadCount()
+*/
+void QQuickWebView::setRasterizationThreads(int count)
+{
+    count = qMax(0, count);
+    if (count == rasterizationThreads())
+        return;
+
+    // Install the new backend first, so that the old rasterizer no longer
+    // has tiles waiting on it when it goes away.
+    QScopedPointer<WebCore::TileQQuickRasterizer> oldRasterizer(d->rasterizer.take());
+    if (count)
+        d->rasterizer.reset(new WebCore::TileQQuickRasterizer(count));
+    if (d->page && d->tiledRendering)
+        d->updateTiledBackingStoreForPage();
+}
+
+int QQuickWebView::rasterizationThreads() const
+{
+    return d->rasterizer ? d->rasterizer->threadCount() : 0;
+}
+
+/*!
+    \property QQuickWebView::paintedPixels
+    \brief the number of pixels rendered for the last frame
+
+    Only the damaged parts of the page are rendered again; this counts the
+    area of the rectangles that were actually painted since the previous
+    frame was synchronized with the scene graph. In tiled mode, the area of
+    every tile update is counted.
+
+    \sa paintedPixelsChanged()
+*/
+qint64 QQuickWebView::paintedPixels() const
+{
+    return d->paintedPixels;
+}
+
+/*!
+    \property QQuickWebView::scrollPosition
+    \brief the scroll position of the main frame, as shown by the view
+
+    In tiled mode, setting this property scrolls asynchronously: the scene
+    graph moves the tiles that are already rendered right away, while tiles
+    are created ahead of the scrolling direction. The main frame itself is
+    only scrolled once the position has not changed for a short while, or
+    before the next input event is delivered to the page, so that flicking
+    does not wait for layout, scroll events or scripts.
+
+    Without tiled rendering, the main frame is scrolled immediately.
+
+    \sa QWebFrame::scrollPosition, tiledRendering
+*/
+void QQuickWebView::setScrollPosition(const QPoint& position)
+{
+    if (!d->page)
+        return;
+
+    QWebFrame* frame = d->page->mainFrame();
+    if (!d->tiledRendering) {
+        frame->setScrollPosition(position);
+        return;
+    }
+
+    const QSize contentsSize = frame->contentsSize();
+    const QSize viewportSize = (QSizeF(d->page->viewportSize()) / d->contentsScale).toSize();
+    QPoint clampedPosition(qBound(0, position.x(), qMax(0, contentsSize.width() - viewportSize.width())),
+                           qBound(0, position.y(), qMax(0, contentsSize.height() - viewportSize.height())));
+    const QPoint oldPosition = scrollPosition();
+    if (clampedPosition == oldPosition)
+        return;
+
+    d->damaged();
+    d->pendingScrollPosition = clampedPosition;
+    d->scrollPending = true;
+    d->scrollSyncTimer.start();
+
+    // Bias the cover rect towards where the content is moving.
+    const QPoint delta = clampedPosition - oldPosition;
+    if (WebCore::TiledBackingStore* backingStore = d->tiledBackingStore())
+        backingStore->coverWithTilesIfNeeded(WebCore::FloatPoint(delta.x(), delta.y()));
+
+    update();
+    emit scrollPositionChanged();
+}
+
+QPoint QQuickWebView::scrollPosition() const
+{
+    if (d->scrollPending)
+        return d->pendingScrollPosition;
+    return d->page ? d->page->mainFrame()->scrollPosition() : QPoint();
+}
+
+/*!
+    \property QQuickWebView::frameTimingHistorySize
+    \brief the number of frames remembered by frameTimings()
+
+    Setting this property discards the frames recorded so far. Setting it
+    to 0 turns the recording off.
+
+    By default, the last 120 frames are remembered.
+
+    \sa frameTimings()
+*/
+void QQuickWebView::setFrameTimingHistorySize(int size)
+{
+    size = qMax(0, size);
+    if (size == d->frameTimingHistorySize)
+        return;
+    d->frameTimingHistorySize = size;
+    clearFrameTimings();
+}
+
+int QQuickWebView::frameTimingHistorySize() const
+{
+    return d->frameTimingHistorySize;
+}
+
+/*!
+    \property QQuickWebView::contentsScale
+    \brief the scale at which the page is shown
+
+    Unlike scaling the item, this rasterizes the page at the new scale, so
+    that text stays crisp when zooming in. While the scale keeps changing,
+    for instance during a pinch gesture, the tiles that are already
+    rasterized are shown scaled and nothing is painted. Once the scale has
+    settled the page is rasterized again at that scale, while the previous
+    tiles stay on screen until the new ones cover the view.
+
+    Mouse and hover positions are mapped to the page accordingly.
+
+    This property only has an effect when tiledRendering is enabled.
+
+    By default, this property is 1.
+
+    \sa tiledRendering, zoomFactor
+*/
+void QQuickWebView::setContentsScale(qreal scale)
+{
+    scale = qMax(qreal(0.01), scale);
+    if (qFuzzyCompare(scale, d->contentsScale))
+        return;
+    d->contentsScale = scale;
+
+    if (d->tiledBackingStore()) {
+        d->scaleCommitTimer.start();
+        d->_q_updateBackingStoreFrozen();
+    }
+    // Keep the scroll position within the contents at the new scale.
+    setScrollPosition(scrollPosition());
+    update();
+    emit contentsScaleChanged();
+}
+
+qreal QQuickWebView::contentsScale() const
+{
+    return d->contentsScale;
+}
+
+/*!
+    Sets the memory, in bytes, that the tiles of all web views in the
+    process may use together to \a bytes.
+
+    Views with tiledRendering enabled draw their tiles from a shared pool.
+    When it holds more than the budget, tiles are evicted, least recently
+    updated first: tiles of hidden views go first, then tiles that views
+    without focus keep around their visible area, then those of the focused
+    view. Tiles that a visible view would create again straight away, those
+    in and just around its visible area, are never evicted, so the budget
+    can be exceeded when many views are shown at once.
+
+    Views rendering into a pixmap are not part of the pool.
+
+    The default budget is 128 MB.
+
+    \sa tileMemoryUsage(), tiledRendering
+*/
+void QQuickWebView::setTileMemoryBudget(qint64 bytes)
+{
+    WebCore::TileQQuickPool::instance()->setBudget(bytes);
+}
+
+/*!
+    Returns the memory budget for the tiles of all web views, in bytes.
+
+    \sa setTileMemoryBudget()
+*/
+qint64 QQuickWebView::tileMemoryBudget()
+{
+    return WebCore::TileQQuickPool::instance()->budget();
+}
+
+/*!
+    Returns the memory, in bytes, currently held by the tiles of all web
+    views, including buffers kept for reuse.
+
+    \sa setTileMemoryBudget()
+*/
+qint64 QQuickWebView::tileMemoryUsage()
+{
+    return WebCore::TileQQuickPool::instance()->usage();
+}
+
+/*!
+    \property QQuickWebView::resizeDelay
+    \brief how long the page waits for the view to stop resizing, in milliseconds
+
+    By default the page is laid out again for every size the view goes
+    through, which is expensive while the geometry is being animated.
+
+    If this property is greater than 0, the page keeps its current size and
+    layout while the view is resized. Until the size has not changed for
+    this long, the view shows the last rendering of the page, scaled to the
+    new width and cropped to the new height, and no content is thrown away.
+
+    By default, this property is 0.
+*/
+void QQuickWebView::setResizeDelay(int msec)
+{
+    msec = qMax(0, msec);
+    if (d->resizeDelay == msec)
+        return;
+    d->resizeDelay = msec;
+    if (d->resizeTimer.isActive())
+        d->_q_applyViewportSize();
+}
+
+int QQuickWebView::resizeDelay() const
+{
+    return d->resizeDelay;
+}
+
+/*!
+    Returns the timings of the most recent frames of the view, oldest
+    first, as a list of maps with the following keys:
+
+    \table
+    \header \li Key \li Description
+    \row \li \c frame \li The number of the frame since the view was created.
+    \row \li \c layoutTime \li Milliseconds spent laying out the page since
+        the previous frame. This includes style recalculations done as part
+        of the layout.
+    \row \li \c styleRecalcTime \li Milliseconds spent recalculating styles
+        since the previous frame.
+    \row \li \c paintTime \li Milliseconds spent painting the page on the
+        GUI thread since the previous frame. Tiles rasterized on worker
+        threads only account for recording their paint commands.
+    \row \li \c uploadBytes \li The number of bytes of images handed to the
+        scene graph for this frame.
+    \row \li \c dirtyArea \li The area, in pixels, of the page that was
+        rendered again for this frame (see paintedPixels).
+    \row \li \c droppedFrames \li The number of screen refreshes that went
+        by between the first change to the page and this frame showing it.
+    \endtable
+
+    The timings are collected for every frame at a negligible cost; this
+    function only copies them out of a ring buffer holding the last
+    frameTimingHistorySize frames.
+
+    \sa clearFrameTimings(), paintedPixels
+*/
+QVariantList QQuickWebView::frameTimings() const
+{
+    QVariantList timings;
+    const int count = d->frameTimings.size();
+    for (int i = 0; i < count; ++i) {
+        const QQuickWebViewPrivate::FrameTiming& timing = d->frameTimings.at((d->frameTimingStart + i) % count);
+        QVariantMap map;
+        map.insert(QLatin1String("frame"), timing.frame);
+        map.insert(QLatin1String("layoutTime"), timing.layoutTime);
+        map.insert(QLatin1String("styleRecalcTime"), timing.styleRecalcTime);
+        map.insert(QLatin1String("paintTime"), timing.paintTime);
+        map.insert(QLatin1String("uploadBytes"), timing.uploadBytes);
+        map.insert(QLatin1String("dirtyArea"), timing.dirtyArea);
+        map.insert(QLatin1String("droppedFrames"), timing.droppedFrames);
+        timings.append(map);
+    }
+    return timings;
+}
+
+/*!
+    Discards the frame timings recorded so far.
+
+    \sa frameTimings()
+*/
+void QQuickWebView::clearFrameTimings()
+{
+    d->frameTimings.clear();
+    d->frameTimings.reserve(d->frameTimingHistorySize);
+    d->frameTimingStart = 0;
+}
+
 
 /*!
     Finds the specified string, \a subString, in the page, using the given \a options.
@@ -860,16 +1645,25 @@ void QQuickWebView::reload()
 void QQuickWebView::geometryChanged(const QRectF &newGeometry,
                                     const QRectF &oldGeometry)
 {
-    QSize size = newGeometry.size().toSize();
-    if (d->page)
-        d->page->setViewportSize(size);
-    d->renderedPage = QPixmap(size);
+    if (newGeometry.size() != oldGeometry.size()) {
+        if (d->resizeDelay > 0)
+            d->resizeTimer.start(d->resizeDelay);
+        else
+            d->_q_applyViewportSize();
+    }
     QQuickPaintedItem::geometryChanged(newGeometry, oldGeometry);
 }
 
 void QQuickWebView::repaint(const QRect &dirtyRect)
 {
-    d->repaintRect = d->repaintRect.united(dirtyRect);
+    d->damaged();
+    if (dirtyRect.isNull())
+        d->repaintRegion = QRect(0, 0, width(), height());
+    else
+        d->repaintRegion += dirtyRect;
+    // Keep the region cheap to maintain when lots of small updates pile up.
+    if (d->repaintRegion.rectCount() > maxRepaintRects)
+        d->repaintRegion = d->repaintRegion.boundingRect();
     if (d->repaintQueued) return;
     d->repaintQueued = true;
     QMetaObject::invokeMethod(this, "_q_repaintReal", Qt::QueuedConnection);
@@ -879,23 +1673,96 @@ void QQuickWebView::repaint(const QRect &dirtyRect)
 */
 void QQuickWebView::paint(QPainter *p)
 {
-    qDebug() << Q_FUNC_INFO;
     if (!d->page)
         return;
-#ifdef QWEBKIT_TIME_RENDERING
-    QTime time;
-    time.start();
-#endif
 
     p->setRenderHints(d->renderHints);
 
-    qDebug() << "Rendering frame";
-    p->drawPixmap(QPoint(0, 0), d->renderedPage);
+    // The pixmap may be larger than the page; only its viewport is valid.
+    const QRect source(QPoint(), d->page->viewportSize());
+    const qreal scale = d->previewScale();
+    if (scale != 1)
+        p->scale(scale, scale);
+    p->drawPixmap(source.topLeft(), d->renderedPage, source);
+    if (!d->compositedLayers.isNull())
+        p->drawImage(QPoint(0, 0), d->compositedLayers);
+}
 
-#ifdef    QWEBKIT_TIME_RENDERING
-    int elapsed = time.elapsed();
-    qDebug() << "paint event on " << ev->region() << ", took to render =  " << elapsed;
-#endif
+/*!
+    \reimp
+*/
+QSGNode* QQuickWebView::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* data)
+{
+    // Runs while the GUI thread is blocked, so this is where a frame ends.
+    const qint64 dirtyArea = d->pendingPaintedPixels;
+    if (d->paintedPixels || d->pendingPaintedPixels) {
+        d->paintedPixels = d->pendingPaintedPixels;
+        d->pendingPaintedPixels = 0;
+        QMetaObject::invokeMethod(this, "paintedPixelsChanged", Qt::QueuedConnection);
+    }
+
+    if (!d->tiledRendering) {
+        if (oldNode && oldNode->type() == QSGNode::ClipNode) {
+            delete oldNode;
+            oldNode = 0;
+        }
+        // paint() draws the composited layers over the page.
+        d->compositedLayersDirty = false;
+        // The painted item uploads its whole image on every update.
+        d->recordFrameTiming(dirtyArea, qint64(width()) * height() * 4);
+        return QQuickPaintedItem::updatePaintNode(oldNode, data);
+    }
+
+    if (oldNode && oldNode->type() != QSGNode::ClipNode) {
+        delete oldNode;
+        oldNode = 0;
+    }
+
+    QQuickWebViewTilesNode* node = static_cast<QQuickWebViewTilesNode*>(oldNode);
+    if (!node) {
+        node = new QQuickWebViewTilesNode;
+        // A new node has no textures, so everything we have must be uploaded.
+        d->dirtyTiles = d->tiles.keys().toSet();
+        d->removedTiles.clear();
+        d->compositedLayersDirty = true;
+    }
+
+    // Retire the old tiles before their removal below takes effect.
+    if (d->retireTiles) {
+        node->retireTiles(d->retiredTileScale);
+        d->retireTiles = false;
+    }
+    if (d->removeRetiredTiles) {
+        node->removeRetiredTiles();
+        d->removeRetiredTiles = false;
+    }
+
+    foreach (int tileID, d->removedTiles)
+        node->removeTile(tileID);
+    d->removedTiles.clear();
+
+    qint64 uploadBytes = 0;
+    foreach (int tileID, d->dirtyTiles) {
+        WebCore::TileQQuick* tile = d->tiles.value(tileID);
+        node->updateTile(window(), tileID, tile->rect(), tile->buffer());
+        uploadBytes += tile->buffer().byteCount();
+    }
+    d->dirtyTiles.clear();
+
+    if (d->compositedLayersDirty) {
+        if (d->compositedLayers.isNull())
+            node->removeLayers();
+        else {
+            node->setLayers(window(), d->compositedLayers);
+            uploadBytes += d->compositedLayers.byteCount();
+        }
+        d->compositedLayersDirty = false;
+    }
+
+    node->setViewportRect(boundingRect());
+    node->setContentsTransform(scrollPosition(), d->contentsScale * d->previewScale(), d->tileScale());
+    d->recordFrameTiming(dirtyArea, uploadBytes);
+    return node;
 }
 
 /*!
@@ -924,7 +1791,7 @@ void QQuickWebView::hoverMoveEvent(QHoverEvent* ev)
 {
     if (d->page) {
         const bool accepted = ev->isAccepted();
-        d->page->event(ev);
+        d->sendHoverEvent(ev);
         ev->setAccepted(accepted);
     }
 }
@@ -935,7 +1802,7 @@ void QQuickWebView::mouseMoveEvent(QMouseEvent* ev)
 {
     if (d->page) {
         const bool accepted = ev->isAccepted();
-        d->page->event(ev);
+        d->sendMouseEvent(ev);
         ev->setAccepted(accepted);
     }
 }
@@ -945,9 +1812,10 @@ void QQuickWebView::mouseMoveEvent(QMouseEvent* ev)
 void QQuickWebView::mousePressEvent(QMouseEvent* ev)
 {
     if (d->page) {
+        d->_q_syncScrollPosition();
         forceActiveFocus();
         const bool accepted = ev->isAccepted();
-        d->page->event(ev);
+        d->sendMouseEvent(ev);
         ev->setAccepted(accepted);
     }
 }
@@ -957,8 +1825,9 @@ void QQuickWebView::mousePressEvent(QMouseEvent* ev)
 void QQuickWebView::mouseDoubleClickEvent(QMouseEvent* ev)
 {
     if (d->page) {
+        d->_q_syncScrollPosition();
         const bool accepted = ev->isAccepted();
-        d->page->event(ev);
+        d->sendMouseEvent(ev);
         ev->setAccepted(accepted);
     }
 }
@@ -968,8 +1837,9 @@ void QQuickWebView::mouseDoubleClickEvent(QMouseEvent* ev)
 void QQuickWebView::mouseReleaseEvent(QMouseEvent* ev)
 {
     if (d->page) {
+        d->_q_syncScrollPosition();
         const bool accepted = ev->isAccepted();
-        d->page->event(ev);
+        d->sendMouseEvent(ev);
         ev->setAccepted(accepted);
     }
 }
@@ -980,6 +1850,7 @@ void QQuickWebView::mouseReleaseEvent(QMouseEvent* ev)
 void QQuickWebView::wheelEvent(QWheelEvent* ev)
 {
     if (d->page) {
+        d->_q_syncScrollPosition();
         const bool accepted = ev->isAccepted();
         d->page->event(ev);
         ev->setAccepted(accepted);
@@ -991,8 +1862,10 @@ void QQuickWebView::wheelEvent(QWheelEvent* ev)
 */
 void QQuickWebView::keyPressEvent(QKeyEvent* ev)
 {
-    if (d->page)
+    if (d->page) {
+        d->_q_syncScrollPosition();
         d->page->event(ev);
+    }
     if (!ev->isAccepted())
         QQuickPaintedItem::keyPressEvent(ev);
 }
@@ -1109,6 +1982,32 @@ void QQuickWebView::inputMethodEvent(QInputMethodEvent *e)
     \sa url(), load()
 */
 
+/*!
+    \fn void QQuickWebView::paintedPixelsChanged()
+
+    This signal is emitted at the end of a frame whenever the value of
+    paintedPixels may have changed.
+
+    \sa paintedPixels
+*/
+
+/*!
+    \fn void QQuickWebView::scrollPositionChanged()
+
+    This signal is emitted whenever the scroll position shown by the view
+    changes, either because it was set or because the page scrolled.
+
+    \sa scrollPosition
+*/
+
+/*!
+    \fn void QQuickWebView::contentsScaleChanged()
+
+    This signal is emitted whenever the contentsScale changes.
+
+    \sa contentsScale
+*/
+
 /*!
     \fn void QQuickWebView::statusBarMessage(const QString& text)
 
@@ -24,6 +24,7 @@
 #include <QtWebKit/qwebkitglobal.h>
 #include <QtWebKit1Quick/qwebpage.h>
 #include <QtCore/qurl.h>
+#include <QtCore/qvariant.h>
 #include <QtGui/qicon.h>
 #include <QtGui/qpainter.h>
 #include <QtNetwork/qnetworkaccessmanager.h>
@@ -52,6 +53,13 @@ class QWEBKITWIDGETS_EXPORT QQuickWebView : public QQuickPaintedItem {
     //Q_PROPERTY(Qt::TextInteractionFlags textInteractionFlags READ textInteractionFlags WRITE setTextInteractionFlags)
     Q_PROPERTY(qreal textSizeMultiplier READ textSizeMultiplier WRITE setTextSizeMultiplier DESIGNABLE false)
     Q_PROPERTY(qreal zoomFactor READ zoomFactor WRITE setZoomFactor)
+    Q_PROPERTY(bool tiledRendering READ tiledRendering WRITE setTiledRendering)
+    Q_PROPERTY(int rasterizationThreads READ rasterizationThreads WRITE setRasterizationThreads)
+    Q_PROPERTY(qint64 paintedPixels READ paintedPixels NOTIFY paintedPixelsChanged)
+    Q_PROPERTY(QPoint scrollPosition READ scrollPosition WRITE setScrollPosition NOTIFY scrollPositionChanged)
+    Q_PROPERTY(int frameTimingHistorySize READ frameTimingHistorySize WRITE setFrameTimingHistorySize)
+    Q_PROPERTY(int resizeDelay READ resizeDelay WRITE setResizeDelay)
+    Q_PROPERTY(qreal contentsScale READ contentsScale WRITE setContentsScale NOTIFY contentsScaleChanged)
 
     Q_PROPERTY(QPainter::RenderHints renderHints READ renderHints WRITE setRenderHints)
     Q_FLAGS(QPainter::RenderHints)
@@ -106,6 +114,32 @@ public:
     void setRenderHints(QPainter::RenderHints hints);
     void setRenderHint(QPainter::RenderHint hint, bool enabled = true);
 
+    void setTiledRendering(bool enabled);
+    bool tiledRendering() const;
+
+    void setRasterizationThreads(int count);
+    int rasterizationThreads() const;
+
+    qint64 paintedPixels() const;
+
+    void setScrollPosition(const QPoint& position);
+    QPoint scrollPosition() const;
+
+    void setResizeDelay(int msec);
+    int resizeDelay() const;
+
+    void setContentsScale(qreal scale);
+    qreal contentsScale() const;
+
+    void setFrameTimingHistorySize(int size);
+    int frameTimingHistorySize() const;
+    Q_INVOKABLE QVariantList frameTimings() const;
+    Q_INVOKABLE void clearFrameTimings();
+
+    static void setTileMemoryBudget(qint64 bytes);
+    static qint64 tileMemoryBudget();
+    static qint64 tileMemoryUsage();
+
     bool findText(const QString& subString, QWebPage::FindFlags options = 0);
 
     void repaint(const QRect &dirtyRect = QRect());
@@ -128,10 +162,14 @@ Q_SIGNALS:
     void selectionChanged();
     void iconChanged();
     void urlChanged(const QUrl&);
+    void paintedPixelsChanged();
+    void scrollPositionChanged();
+    void contentsScaleChanged();
 
 protected:
     virtual void geometryChanged(const QRectF &, const QRectF &);
     virtual void paint(QPainter*);
+    virtual QSGNode* updatePaintNode(QSGNode*, UpdatePaintNodeData*);
 
     virtual QQuickWebView *createWindow(QWebPage::WebWindowType type);
 
@@ -159,6 +197,12 @@ private:
     Q_PRIVATE_SLOT(d, void _q_pageDestroyed())
     Q_PRIVATE_SLOT(d, void _q_repaintReal())
     Q_PRIVATE_SLOT(d, void _q_contentsSizeChanged(const QSize&))
+    Q_PRIVATE_SLOT(d, void _q_syncCompositedLayers())
+    Q_PRIVATE_SLOT(d, void _q_clearCompositedLayers())
+    Q_PRIVATE_SLOT(d, void _q_syncScrollPosition())
+    Q_PRIVATE_SLOT(d, void _q_applyViewportSize())
+    Q_PRIVATE_SLOT(d, void _q_commitContentsScale())
+    Q_PRIVATE_SLOT(d, void _q_updateBackingStoreFrozen())
 };
 
 #endif // QWEBVIEW_H
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "config.h"
+#include "qquickwebviewnode_p.h"
+
+#include <QtQuick/qquickwindow.h>
+#include <QtQuick/qsgtexture.h>
+
+QQuickWebViewTileNode::QQuickWebViewTileNode()
+    : m_texture(0)
+{
+}
+
+QQuickWebViewTileNode::~QQuickWebViewTileNode()
+{
+    delete m_texture;
+}
+
+void QQuickWebViewTileNode::setImage(QQuickWindow* window, const QImage& image)
+{
+    QSGTexture* texture = window->createTextureFromImage(image);
+    setTexture(texture);
+    delete m_texture;
+    m_texture = texture;
+}
+
+QQuickWebViewTilesNode::QQuickWebViewTilesNode()
+    : m_contentsNode(new QSGTransformNode)
+    , m_retiredNode(0)
+    , m_retiredTileScale(1)
+    , m_layersNode(0)
+{
+    setIsRectangular(true);
+    appendChildNode(m_contentsNode);
+}
+
+void QQuickWebViewTilesNode::setViewportRect(const QRectF& rect)
+{
+    if (clipRect() == rect)
+        return;
+    setClipRect(rect);
+    markDirty(QSGNode::DirtyGeometry);
+}
+
+static void setTileTransform(QSGTransformNode* node, const QPoint& scrollPosition, qreal scale, qreal tileScale)
+{
+    QMatrix4x4 matrix;
+    matrix.scale(scale / tileScale);
+    matrix.translate(-scrollPosition.x() * tileScale, -scrollPosition.y() * tileScale);
+    if (node->matrix() == matrix)
+        return;
+    node->setMatrix(matrix);
+}
+
+void QQuickWebViewTilesNode::setContentsTransform(const QPoint& scrollPosition, qreal scale, qreal tileScale)
+{
+    setTileTransform(m_contentsNode, scrollPosition, scale, tileScale);
+    if (m_retiredNode)
+        setTileTransform(m_retiredNode, scrollPosition, scale, m_retiredTileScale);
+}
+
+void QQuickWebViewTilesNode::updateTile(QQuickWindow* window, int tileID, const QRect& tileRect, const QImage& image)
+{
+    QQuickWebViewTileNode* node = m_tileNodes.value(tileID);
+    if (!node) {
+        node = new QQuickWebViewTileNode;
+        m_contentsNode->appendChildNode(node);
+        m_tileNodes.insert(tileID, node);
+    }
+    node->setRect(tileRect);
+    node->setImage(window, image);
+}
+
+void QQuickWebViewTilesNode::removeTile(int tileID)
+{
+    QQuickWebViewTileNode* node = m_tileNodes.take(tileID);
+    if (!node)
+        return;
+    m_contentsNode->removeChildNode(node);
+    delete node;
+}
+
+void QQuickWebViewTilesNode::setLayers(QQuickWindow* window, const QImage& image)
+{
+    if (!m_layersNode) {
+        m_layersNode = new QQuickWebViewTileNode;
+        appendChildNode(m_layersNode);
+    }
+    m_layersNode->setRect(QRectF(QPointF(), image.size()));
+    m_layersNode->setImage(window, image);
+}
+
+void QQuickWebViewTilesNode::removeLayers()
+{
+    if (!m_layersNode)
+        return;
+    removeChildNode(m_layersNode);
+    delete m_layersNode;
+    m_layersNode = 0;
+}
+
+void QQuickWebViewTilesNode::retireTiles(qreal tileScale)
+{
+    if (m_tileNodes.isEmpty())
+        return;
+
+    // Only the most recent generation is kept; it is the closest match.
+    removeRetiredTiles();
+    m_retiredNode = new QSGTransformNode;
+    m_retiredTileScale = tileScale;
+    prependChildNode(m_retiredNode);
+
+    foreach (QQuickWebViewTileNode* node, m_tileNodes) {
+        m_contentsNode->removeChildNode(node);
+        m_retiredNode->appendChildNode(node);
+    }
+    m_tileNodes.clear();
+}
+
+void QQuickWebViewTilesNode::removeRetiredTiles()
+{
+    if (!m_retiredNode)
+        return;
+    removeChildNode(m_retiredNode);
+    // The tiles are owned by their parent and go away with it.
+    delete m_retiredNode;
+    m_retiredNode = 0;
+}
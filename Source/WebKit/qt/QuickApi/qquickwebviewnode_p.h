@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef QQUICKWEBVIEWNODE_P_H
+#define QQUICKWEBVIEWNODE_P_H
+
+#include <QHash>
+#include <QImage>
+#include <QRect>
+#include <QtQuick/qsgnode.h>
+#include <QtQuick/qsgsimpletexturenode.h>
+
+QT_BEGIN_NAMESPACE
+class QQuickWindow;
+class QSGTexture;
+QT_END_NAMESPACE
+
+// A single tile of the page contents, backed by its own texture.
+class QQuickWebViewTileNode : public QSGSimpleTextureNode {
+public:
+    QQuickWebViewTileNode();
+    ~QQuickWebViewTileNode();
+
+    void setImage(QQuickWindow*, const QImage&);
+
+private:
+    QSGTexture* m_texture;
+};
+
+// Root of the tiled rendering path. Tiles are positioned in contents
+// coordinates below a transform node, so that scrolling and zooming only
+// change the transform and never touch the textures. After a change of
+// the tile scale, the tiles rasterized at the previous scale can be kept
+// below the new ones until those cover the view. The composited layers,
+// if any, are drawn on top of them in viewport coordinates.
+class QQuickWebViewTilesNode : public QSGClipNode {
+public:
+    QQuickWebViewTilesNode();
+
+    void setViewportRect(const QRectF&);
+    // Shows the contents from scrollPosition on, at the given scale, out
+    // of tiles rasterized at tileScale.
+    void setContentsTransform(const QPoint& scrollPosition, qreal scale, qreal tileScale);
+
+    bool hasTile(int tileID) const { return m_tileNodes.contains(tileID); }
+    void updateTile(QQuickWindow*, int tileID, const QRect& tileRect, const QImage&);
+    void removeTile(int tileID);
+
+    void retireTiles(qreal tileScale);
+    void removeRetiredTiles();
+
+    void setLayers(QQuickWindow*, const QImage&);
+    void removeLayers();
+
+private:
+    QSGTransformNode* m_contentsNode;
+    QSGTransformNode* m_retiredNode;
+    qreal m_retiredTileScale;
+    QQuickWebViewTileNode* m_layersNode;
+    QHash<int, QQuickWebViewTileNode*> m_tileNodes;
+};
+
+#endif // QQUICKWEBVIEWNODE_P_H
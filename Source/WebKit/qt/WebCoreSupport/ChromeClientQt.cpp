@@ -668,6 +668,9 @@ IntRect ChromeClientQt::visibleRectForTiledBackingStore() const
         return IntRect();
 
     if (!platformPageClient()->viewResizesToContentsEnabled()) {
+        const QRect clientRect = platformPageClient()->tiledBackingStoreVisibleRect();
+        if (!clientRect.isEmpty())
+            return clientRect;
         const QPoint ofs = m_webPage->mainFrameAdapter()->scrollPosition();
         IntSize offset(ofs.x(), ofs.y());
         return QRect(QPoint(offset.width(), offset.height()), m_webPage->mainFrameAdapter()->frameRect().size());
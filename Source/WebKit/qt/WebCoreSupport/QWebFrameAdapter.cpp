@@ -432,6 +432,11 @@ QUrl QWebFrameAdapter::baseUrl() const
 }
 
 #if USE(ACCELERATED_COMPOSITING)
+static inline bool compositesLayersSeparately(QWebPageAdapter* pageAdapter)
+{
+    return pageAdapter->client && pageAdapter->client->compositesLayersSeparately();
+}
+
 void QWebFrameAdapter::renderCompositedLayers(WebCore::GraphicsContext* context, const WebCore::IntRect& clip)
 {
     WebCore::Page* page = frame->page();
@@ -533,7 +538,8 @@ void QWebFrameAdapter::renderRelativeCoords(QPainter* painter, int layers, const
             context.restore();
         }
 #if USE(ACCELERATED_COMPOSITING)
-        renderCompositedLayers(&context, IntRect(clipBoundingRect));
+        if (!compositesLayersSeparately(pageAdapter))
+            renderCompositedLayers(&context, IntRect(clipBoundingRect));
 #endif
     }
     renderFrameExtras(&context, layers, clip);
@@ -647,7 +653,8 @@ bool QWebFrameAdapter::renderFromTiledBackingStore(QPainter* painter, const QReg
     }
 
 #if USE(ACCELERATED_COMPOSITING)
-    renderCompositedLayers(&context, IntRect(clip.boundingRect()));
+    if (!compositesLayersSeparately(pageAdapter))
+        renderCompositedLayers(&context, IntRect(clip.boundingRect()));
     renderFrameExtras(&context, QWebFrameAdapter::ScrollBarLayer | QWebFrameAdapter::PanIconLayer, clip);
 #endif
     return true;
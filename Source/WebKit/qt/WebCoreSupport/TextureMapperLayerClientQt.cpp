@@ -78,6 +78,9 @@ void TextureMapperLayerClientQt::setRootGraphicsLayer(GraphicsLayer* layer)
     } else {
         m_rootGraphicsLayer.clear();
         m_rootTextureMapperLayer = 0;
+        QWebPageClient* client = m_frame->pageAdapter->client.data();
+        if (client && client->compositesLayersSeparately())
+            client->didDetachCompositedLayers();
     }
 }
 
@@ -94,7 +97,13 @@ void TextureMapperLayerClientQt::syncLayers(Timer<TextureMapperLayerClientQt>*)
     if (rootLayer()->descendantsOrSelfHaveRunningAnimations() && !m_syncTimer.isActive())
         m_syncTimer.startOneShot(1.0 / 60.0);
 
-    m_frame->pageAdapter->client->repaintViewport();
+    QWebPageClient* client = m_frame->pageAdapter->client.data();
+    if (!client)
+        return;
+    if (client->compositesLayersSeparately())
+        client->didSyncCompositedLayers();
+    else
+        client->repaintViewport();
 }
 
 void TextureMapperLayerClientQt::renderCompositedLayers(GraphicsContext* context, const IntRect& clip)
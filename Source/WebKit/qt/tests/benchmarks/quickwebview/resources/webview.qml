@@ -0,0 +1,8 @@
+import QtQuick 2.0
+import QtWebKit1 1.0
+
+WebView {
+    width: 1024
+    height: 768
+    frameTimingHistorySize: 1000
+}
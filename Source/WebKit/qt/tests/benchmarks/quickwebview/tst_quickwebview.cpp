@@ -0,0 +1,274 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <QtTest/QtTest>
+
+#include <QGuiApplication>
+#include <QQmlEngine>
+#include <QQuickItem>
+#include <QQuickView>
+
+#include "util.h"
+
+#if !defined(IMPORT_DIR)
+#define IMPORT_DIR ""
+#endif
+
+// Number of frames each scenario drives.
+static const int framesPerRun = 200;
+
+// How long to wait for a frame before considering the view idle.
+static const int frameTimeout = 1000;
+
+static qreal percentile(QList<qreal> values, qreal fraction)
+{
+    if (values.isEmpty())
+        return 0;
+    qSort(values);
+    return values.at(qMin(values.size() - 1, int(fraction * values.size())));
+}
+
+// Returns the peak resident memory of the process in bytes, or -1 where
+// it is not known.
+static qint64 peakMemory()
+{
+#if defined(Q_OS_LINUX)
+    QFile status(QLatin1String("/proc/self/status"));
+    if (!status.open(QIODevice::ReadOnly))
+        return -1;
+    while (!status.atEnd()) {
+        QByteArray line = status.readLine();
+        if (line.startsWith("VmHWM:"))
+            return line.mid(6).trimmed().split(' ').first().toLongLong() * 1024;
+    }
+#endif
+    return -1;
+}
+
+static void resetPeakMemory()
+{
+#if defined(Q_OS_LINUX)
+    // Supported since Linux 4.0; older kernels keep the peak of the process.
+    QFile clearRefs(QLatin1String("/proc/self/clear_refs"));
+    if (clearRefs.open(QIODevice::WriteOnly))
+        clearRefs.write("5");
+#endif
+}
+
+class tst_QuickWebView : public QObject
+{
+    Q_OBJECT
+
+public:
+    typedef void (tst_QuickWebView::*Step)(int frame);
+
+public Q_SLOTS:
+    void init();
+    void cleanup();
+
+private Q_SLOTS:
+    void scroll_data();
+    void scroll();
+    void resize_data();
+    void resize();
+    void mutate_data();
+    void mutate();
+
+private:
+    void corpus();
+    QVariant evaluateJavaScript(const QString& script);
+    void measure(Step);
+
+    void scrollStep(int frame);
+    void resizeStep(int frame);
+    void mutateStep(int frame);
+
+    QQuickView* m_window;
+    QQuickItem* m_view;
+    int m_scrollHeight;
+};
+
+void tst_QuickWebView::init()
+{
+    m_window = new QQuickView;
+    m_window->engine()->addImportPath(QLatin1String(IMPORT_DIR));
+    m_window->setResizeMode(QQuickView::SizeRootObjectToView);
+    m_window->setSource(QUrl(QLatin1String("qrc:///resources/webview.qml")));
+    m_view = m_window->rootObject();
+    QVERIFY2(m_view, "QtWebKit1 QML plugin not found");
+
+    m_window->resize(1024, 768);
+    m_window->show();
+    m_scrollHeight = 0;
+}
+
+void tst_QuickWebView::cleanup()
+{
+    delete m_window;
+}
+
+void tst_QuickWebView::corpus()
+{
+    QTest::addColumn<QUrl>("url");
+    QTest::addColumn<bool>("tiledRendering");
+
+    const char* pages[] = { "text", "table", "effects" };
+    for (unsigned i = 0; i < sizeof(pages) / sizeof(pages[0]); ++i) {
+        QUrl url(QString(QLatin1String("qrc:///resources/%1.html")).arg(QLatin1String(pages[i])));
+        QTest::newRow(QByteArray(pages[i]).append("-pixmap").constData()) << url << false;
+        QTest::newRow(QByteArray(pages[i]).append("-tiled").constData()) << url << true;
+    }
+}
+
+QVariant tst_QuickWebView::evaluateJavaScript(const QString& script)
+{
+    // The view is only known through QML, so its main frame, the first
+    // QWebFrame child of its page, is called through its meta object.
+    QObject* page = 0;
+    foreach (QObject* child, m_view->children()) {
+        if (child->inherits("QWebPage"))
+            page = child;
+    }
+    QObject* mainFrame = 0;
+    if (page) {
+        foreach (QObject* child, page->children()) {
+            if (!mainFrame && child->inherits("QWebFrame"))
+                mainFrame = child;
+        }
+    }
+    if (!mainFrame)
+        return QVariant();
+
+    QVariant result;
+    QMetaObject::invokeMethod(mainFrame, "evaluateJavaScript", Q_RETURN_ARG(QVariant, result), Q_ARG(QString, script));
+    return result;
+}
+
+void tst_QuickWebView::measure(Step step)
+{
+    QFETCH(QUrl, url);
+    QFETCH(bool, tiledRendering);
+
+    m_view->setProperty("tiledRendering", tiledRendering);
+    m_view->setProperty("url", url);
+    QVERIFY(::waitForSignal(m_view, SIGNAL(loadFinished(bool))));
+    m_scrollHeight = evaluateJavaScript(QLatin1String("document.documentElement.scrollHeight - window.innerHeight")).toInt();
+
+    // Let the first frames, which rasterize the whole view, settle.
+    m_view->update();
+    if (!::waitForSignal(m_window, SIGNAL(frameSwapped()), frameTimeout * 10))
+        QSKIP("The scene graph does not render; an OpenGL implementation, such as Mesa's software one, is required");
+    while (::waitForSignal(m_window, SIGNAL(frameSwapped()), frameTimeout / 10)) { }
+
+    QMetaObject::invokeMethod(m_view, "clearFrameTimings");
+    resetPeakMemory();
+
+    int frames = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < framesPerRun; ++i) {
+        (this->*step)(i);
+        if (::waitForSignal(m_window, SIGNAL(frameSwapped()), frameTimeout))
+            ++frames;
+    }
+    qint64 elapsed = qMax(qint64(1), timer.elapsed());
+
+    QVariantList timings;
+    QMetaObject::invokeMethod(m_view, "frameTimings", Q_RETURN_ARG(QVariantList, timings));
+    QList<qreal> paintTimes;
+    foreach (const QVariant& timing, timings)
+        paintTimes.append(timing.toMap().value(QLatin1String("paintTime")).toReal());
+
+    qDebug("paint time (ms): p50 %.2f, p90 %.2f, p99 %.2f, max %.2f",
+        percentile(paintTimes, 0.5), percentile(paintTimes, 0.9), percentile(paintTimes, 0.99), percentile(paintTimes, 1));
+    qint64 peak = peakMemory();
+    if (peak >= 0)
+        qDebug("peak memory: %lld kB", peak / 1024);
+
+    QTest::setBenchmarkResult(frames * 1000.0 / elapsed, QTest::FramesPerSecond);
+}
+
+void tst_QuickWebView::scrollStep(int frame)
+{
+    // Scroll down the page and back up again, 40 pixels per frame.
+    const int stride = 40;
+    int range = qMax(1, m_scrollHeight / stride);
+    int position = frame % (2 * range);
+    if (position > range)
+        position = 2 * range - position;
+    m_view->setProperty("scrollPosition", QPoint(0, position * stride));
+}
+
+void tst_QuickWebView::resizeStep(int frame)
+{
+    // Narrow the view down to 640 pixels and widen it back, as when a
+    // window edge is dragged.
+    const int steps = 12;
+    int position = frame % (2 * steps);
+    if (position > steps)
+        position = 2 * steps - position;
+    m_window->resize(1024 - position * 32, 768);
+}
+
+void tst_QuickWebView::mutateStep(int frame)
+{
+    // Each page of the corpus changes some of its content in its own way.
+    evaluateJavaScript(QString(QLatin1String("benchmarkMutate(%1)")).arg(frame));
+}
+
+void tst_QuickWebView::scroll_data()
+{
+    corpus();
+}
+
+void tst_QuickWebView::scroll()
+{
+    measure(&tst_QuickWebView::scrollStep);
+}
+
+void tst_QuickWebView::resize_data()
+{
+    corpus();
+}
+
+void tst_QuickWebView::resize()
+{
+    measure(&tst_QuickWebView::resizeStep);
+}
+
+void tst_QuickWebView::mutate_data()
+{
+    corpus();
+}
+
+void tst_QuickWebView::mutate()
+{
+    measure(&tst_QuickWebView::mutateStep);
+}
+
+int main(int argc, char** argv)
+{
+    // Run headless unless told otherwise, with -platform or the environment.
+    if (qgetenv("QT_QPA_PLATFORM").isEmpty())
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QGuiApplication app(argc, argv);
+    tst_QuickWebView test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "tst_quickwebview.moc"
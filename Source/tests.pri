@@ -33,6 +33,8 @@ SUBDIRS += \
     $$WEBKIT_TESTS_DIR/benchmarks/painting \
     $$WEBKIT_TESTS_DIR/benchmarks/loading
 
+have?(QTQUICK): SUBDIRS += $$WEBKIT_TESTS_DIR/benchmarks/quickwebview
+
 # WebGL performance tests are disabled temporarily.
 # https://bugs.webkit.org/show_bug.cgi?id=80503
 #